@@ -0,0 +1,176 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+using csdl.Enums;
+using csdl.Native;
+using JetBrains.Annotations;
+
+namespace csdl.Tests;
+
+[TestSubject(typeof(NativeEvents))]
+public class NativeEventTests : IDisposable
+{
+    // larger than any record, so polling one at a time doesn't need to know the native stride
+    private const int RecordBufferSize = 1024;
+
+    private readonly IntPtr _session;
+    private readonly IntPtr _record = Marshal.AllocHGlobal(RecordBufferSize);
+    private readonly string _tempSavePath = Path.Combine(Path.GetTempPath(), "csdl-native-test");
+
+    public unsafe NativeEventTests()
+    {
+        var pack = NativeMethods.CreateSettingsPack();
+
+        // keep the session off the network, so the only alerts are the ones the tests ask for
+        NativeMethods.SettingsPackSetString(pack, "listen_interfaces", "127.0.0.1:0");
+        NativeMethods.SettingsPackSetBool(pack, "enable_dht", false);
+        NativeMethods.SettingsPackSetBool(pack, "enable_lsd", false);
+        NativeMethods.SettingsPackSetBool(pack, "enable_upnp", false);
+        NativeMethods.SettingsPackSetBool(pack, "enable_natpmp", false);
+
+        _session = NativeMethods.CreateSession(pack.ToPointer());
+        NativeMethods.FreeSettingsPack(pack);
+    }
+
+    public void Dispose()
+    {
+        NativeMethods.FreeSession(_session);
+        Marshal.FreeHGlobal(_record);
+
+        if (Directory.Exists(_tempSavePath))
+        {
+            Directory.Delete(_tempSavePath, true);
+        }
+    }
+
+    [Fact]
+    public async Task TestPollingOverflow()
+    {
+        const int capacity = 8;
+        const int posted = 64;
+
+        NativeMethods.SetEventPolling(_session, capacity, NativeEvents.EventFlags.None);
+
+        for (var i = 0; i < posted; i++)
+        {
+            NativeMethods.PostSessionStats(_session);
+        }
+
+        // nothing is polled, so everything past the ring's capacity is dropped
+        await WaitFor(() => NativeMethods.GetDroppedAlertCount(_session) >= posted - capacity);
+        Assert.Equal(posted - capacity, NativeMethods.GetDroppedAlertCount(_session));
+
+        Assert.Equal(1, NativeMethods.PollAlerts(_session, _record, 1));
+
+        var polled = Marshal.PtrToStructure<NativeEvents.SessionStatsAlert>(_record);
+        var counters = ReadCounters(polled);
+
+        Assert.Equal(AlertType.SessionStats, polled.info.type);
+        Assert.NotEmpty(counters);
+
+        // the polled slot stays lent out until the next poll, so the pump drops anything else it pops in the meantime
+        var dropped = NativeMethods.GetDroppedAlertCount(_session);
+        NativeMethods.PostSessionStats(_session);
+
+        await WaitFor(() => NativeMethods.GetDroppedAlertCount(_session) > dropped);
+        Assert.Equal(counters, ReadCounters(polled));
+
+        // the rest of the ring is still intact
+        var remaining = 0;
+
+        while (NativeMethods.PollAlerts(_session, _record, 1) == 1)
+        {
+            Assert.Equal(AlertType.SessionStats, Marshal.PtrToStructure<NativeEvents.AlertBase>(_record).type);
+            remaining++;
+        }
+
+        Assert.Equal(capacity - 1, remaining);
+    }
+
+    [Fact]
+    public async Task TestAlertFilter()
+    {
+        var included = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var excluded = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "ubuntu-20.04.6-live-server-amd64.iso.torrent")));
+        var includedHash = Convert.FromHexString(included.Metadata.InfoHash);
+
+        NativeMethods.SetEventPolling(_session, 1024, NativeEvents.EventFlags.None);
+
+        unsafe
+        {
+            fixed (byte* hashPtr = includedHash)
+            {
+                var filter = new NativeEvents.AlertFilter
+                {
+                    alert_types = (1u << (int)AlertType.TorrentStatus) | (1u << (int)AlertType.TorrentRemoved),
+                    peer_alert_types = uint.MaxValue,
+                    category_mask = -1,
+                    info_hash_count = 1,
+                    info_hashes = (IntPtr)hashPtr
+                };
+
+                // the filter copies the hashes, so they only need pinning for the call
+                NativeMethods.SetAlertFilter(_session, in filter);
+            }
+        }
+
+        var includedHandle = NativeMethods.AttachTorrent(_session, included.InfoHandle, _tempSavePath);
+        var excludedHandle = NativeMethods.AttachTorrent(_session, excluded.InfoHandle, _tempSavePath);
+
+        // session stats aren't in the allowed types
+        NativeMethods.PostSessionStats(_session);
+
+        // removals are processed in order, so by the time the included torrent's arrives everything before it has been filtered
+        NativeMethods.DetachTorrent(_session, excludedHandle);
+        NativeMethods.DetachTorrent(_session, includedHandle);
+
+        var records = new List<(AlertType Type, byte[] InfoHash)>();
+
+        await WaitFor(() =>
+        {
+            while (NativeMethods.PollAlerts(_session, _record, 1) == 1)
+            {
+                var type = Marshal.PtrToStructure<NativeEvents.AlertBase>(_record).type;
+
+                records.Add(type switch
+                {
+                    AlertType.TorrentStatus => (type, Marshal.PtrToStructure<NativeEvents.TorrentStatusAlert>(_record).info_hash),
+                    AlertType.TorrentRemoved => (type, Marshal.PtrToStructure<NativeEvents.TorrentRemovedAlert>(_record).info_hash),
+                    _ => (type, null)
+                });
+            }
+
+            return records.Any(x => x.Type == AlertType.TorrentRemoved);
+        });
+
+        Assert.All(records, x => Assert.True(x.Type is AlertType.TorrentStatus or AlertType.TorrentRemoved));
+        Assert.All(records, x => Assert.Equal(includedHash, x.InfoHash));
+        Assert.Single(records, x => x.Type == AlertType.TorrentRemoved);
+    }
+
+    private static long[] ReadCounters(NativeEvents.SessionStatsAlert alert)
+    {
+        var counters = new long[alert.count];
+        Marshal.Copy(alert.counters, counters, 0, counters.Length);
+
+        return counters;
+    }
+
+    private static async Task WaitFor(Func<bool> condition)
+    {
+        var deadline = DateTime.UtcNow.AddSeconds(30);
+
+        while (!condition() && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(10);
+        }
+
+        Assert.True(condition());
+    }
+}
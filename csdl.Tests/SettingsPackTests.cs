@@ -3,6 +3,7 @@
 
 using System;
 using System.Net;
+using System.Runtime.InteropServices;
 using csdl.Native;
 using csdl.Utils;
 using JetBrains.Annotations;
@@ -56,6 +57,41 @@ namespace csdl.Tests
             NativeMethods.FreeSettingsPack(nativePack);
         }
 
+        [Fact]
+        public void TestNativeSettingsPack()
+        {
+            var nativePack = NativeMethods.CreateSettingsPack();
+
+            try
+            {
+                Assert.True(NativeMethods.SettingsPackSetString(nativePack, "user_agent", "csdl/test"));
+                Assert.True(NativeMethods.SettingsPackSetBool(nativePack, "enable_dht", false));
+                Assert.True(NativeMethods.SettingsPackSetInt(nativePack, "connections_limit", 123));
+
+                // keys are matched regardless of case, and only against settings of the right type
+                Assert.Equal("csdl/test", Marshal.PtrToStringUTF8(NativeMethods.SettingsPackGetString(nativePack, "USER_AGENT")));
+                Assert.True(NativeMethods.SettingsPackGetBool(nativePack, "Enable_DHT", out var dhtEnabled));
+                Assert.False(dhtEnabled);
+                Assert.True(NativeMethods.SettingsPackGetInt(nativePack, "connections_limit", out var connectionsLimit));
+                Assert.Equal(123, connectionsLimit);
+
+                Assert.False(NativeMethods.SettingsPackSetInt(nativePack, "user_agent", 1));
+                Assert.False(NativeMethods.SettingsPackGetInt(nativePack, "enable_dht", out _));
+                Assert.False(NativeMethods.SettingsPackGetBool(nativePack, "enable_lsd", out _));
+                Assert.Equal(IntPtr.Zero, NativeMethods.SettingsPackGetString(nativePack, "invalid_data"));
+            }
+            finally
+            {
+                NativeMethods.FreeSettingsPack(nativePack);
+            }
+
+            // the first setting of each type (string, int then bool)
+            Assert.Equal("user_agent", Marshal.PtrToStringUTF8(NativeMethods.GetSettingsKeyName(0x0000)));
+            Assert.Equal("tracker_completion_timeout", Marshal.PtrToStringUTF8(NativeMethods.GetSettingsKeyName(0x4000)));
+            Assert.Equal("allow_multiple_connections_per_ip", Marshal.PtrToStringUTF8(NativeMethods.GetSettingsKeyName(0x8000)));
+            Assert.Equal(IntPtr.Zero, NativeMethods.GetSettingsKeyName(-1));
+        }
+
         public void Dispose()
         {
             _client?.Dispose();
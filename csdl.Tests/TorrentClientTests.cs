@@ -2,8 +2,11 @@
 // Licensed under Apache-2.0 - see the license file for more information
 
 using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Net;
 using System.Threading;
 using System.Threading.Tasks;
 using csdl.Alerts;
@@ -66,11 +69,24 @@ public class TorrentClientTests : IDisposable
             torrentManager.ReannounceAllTrackers(TimeSpan.Zero);
 
             // check all files have been downloaded and are the correct size
+            var progress = torrentManager.GetFileProgress(pieceGranularity: false);
+
             foreach (var file in torrentManager.Files.Where(x => x.Priority != FileDownloadPriority.DoNotDownload))
             {
                 Assert.True(File.Exists(file.Path));
                 Assert.Equal(file.Info.FileSize, new FileInfo(file.Path).Length);
+                Assert.Equal(file.Info.FileSize, progress[file.Info.Index]);
             }
+
+            // verified pieces can be read back through the native piece buffer
+            var pieces = torrentManager.GetExtendedStatus(TorrentStatusFields.Pieces).Pieces;
+            var pieceIndex = Enumerable.Range(0, pieces.Length).First(i => pieces[i]);
+
+            var piece = await ReadPiece(torrentManager, pieceIndex);
+            using var buffer = piece.Buffer;
+
+            Assert.Equal(0, piece.ErrorCode);
+            Assert.True(buffer.Span.Length > 0);
         }
         finally
         {
@@ -80,6 +96,587 @@ public class TorrentClientTests : IDisposable
         Assert.True(!_client.ActiveTorrents.Contains(torrentManager));
     }
 
+    [Fact]
+    public async Task TestBulkTorrentStatus()
+    {
+        var torrentInfo = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var torrentManager = _client.AttachTorrent(torrentInfo, _tempSavePath);
+
+        try
+        {
+            var statuses = _client.GetAllTorrentStatus();
+
+            Assert.Single(statuses);
+            Assert.True(statuses.ContainsKey(torrentManager));
+        }
+        finally
+        {
+            await PerformCleanup(torrentManager);
+        }
+    }
+
+    [Fact]
+    public async Task TestStatusUpdates()
+    {
+        var updates = new ConcurrentQueue<TorrentStatusUpdateAlert>();
+        EventHandler<SessionAlert> handler = (_, alert) =>
+        {
+            if (alert is TorrentStatusUpdateAlert updateAlert)
+            {
+                updates.Enqueue(updateAlert);
+            }
+        };
+
+        var torrentInfo = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var torrentManager = _client.AttachTorrent(torrentInfo, _tempSavePath);
+
+        foreach (var file in torrentManager.Files)
+        {
+            file.Priority = FileDownloadPriority.DoNotDownload;
+        }
+
+        _client.AlertRaised += handler;
+
+        try
+        {
+            _client.SetStatusUpdateInterval(TimeSpan.FromMilliseconds(100));
+
+            // the first update includes the torrent as it hasn't been reported yet
+            await WaitForStatusUpdate(updates, torrentManager);
+            updates.Clear();
+
+            // starting the torrent changes its state, so it should be reported again
+            torrentManager.Start();
+
+            await WaitForStatusUpdate(updates, torrentManager);
+        }
+        finally
+        {
+            _client.SetStatusUpdateInterval(TimeSpan.Zero);
+            _client.AlertRaised -= handler;
+
+            await PerformCleanup(torrentManager);
+        }
+    }
+
+    [Fact]
+    public async Task TestNativeMetrics()
+    {
+        var torrentInfo = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var torrentManager = _client.AttachTorrent(torrentInfo, _tempSavePath);
+
+        NativeMetrics.Enabled = true;
+
+        try
+        {
+            var before = NativeMetrics.Get(NativeMetric.GetAllTorrentStatus);
+            _client.GetAllTorrentStatus();
+            var after = NativeMetrics.Get(NativeMetric.GetAllTorrentStatus);
+
+            Assert.True(after.Count > before.Count);
+            Assert.True(after.Max > 0);
+            Assert.True(after.EstimatePercentile(99) <= after.Max);
+        }
+        finally
+        {
+            NativeMetrics.Enabled = false;
+            await PerformCleanup(torrentManager);
+        }
+    }
+
+    [Fact]
+    public async Task TestFilePriorities()
+    {
+        var torrentInfo = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var torrentManager = _client.AttachTorrent(torrentInfo, _tempSavePath);
+
+        try
+        {
+            var priorities = Enumerable.Repeat(FileDownloadPriority.Low, torrentInfo.Files.Count).ToArray();
+            torrentManager.SetFilePriorities(priorities);
+
+            Assert.Equal(priorities, torrentManager.GetFilePriorities());
+
+            // sparse updates should only touch the files given
+            torrentManager.UpdateFilePriorities(new Dictionary<int, FileDownloadPriority> { [0] = FileDownloadPriority.High });
+            priorities[0] = FileDownloadPriority.High;
+
+            Assert.Equal(priorities, torrentManager.GetFilePriorities());
+            Assert.Equal(FileDownloadPriority.High, torrentManager.Files[0].Priority);
+        }
+        finally
+        {
+            await PerformCleanup(torrentManager);
+        }
+    }
+
+    [Fact]
+    public async Task TestStreamWindow()
+    {
+        var torrentInfo = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var torrentManager = _client.AttachTorrent(torrentInfo, _tempSavePath);
+
+        try
+        {
+            var file = torrentManager.Files.MaxBy(x => x.Info.FileSize);
+
+            using var stream = torrentManager.OpenStream(file, readAheadBytes: 1024 * 1024);
+            var openedStats = stream.GetStats();
+
+            // nothing has been downloaded yet
+            Assert.Null(openedStats.TimeToFirstByte);
+            Assert.Equal(0, stream.AvailableBytes);
+            Assert.True(openedStats.WindowLastPiece >= openedStats.WindowFirstPiece);
+
+            // jumping past the window should move it along with the reader
+            stream.Position = file.Info.FileSize / 2;
+            var seekStats = stream.GetStats();
+
+            Assert.Equal(1, seekStats.SeekCount);
+            Assert.Equal(file.Info.FileSize / 2, seekStats.Position);
+            Assert.True(seekStats.WindowFirstPiece > openedStats.WindowLastPiece);
+        }
+        finally
+        {
+            await PerformCleanup(torrentManager);
+        }
+    }
+
+    [Fact]
+    public async Task TestBatchAttach()
+    {
+        var torrents = new[]
+        {
+            new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent"))),
+            new TorrentInfo(Path.GetFullPath(Path.Combine("files", "ubuntu-20.04.6-live-server-amd64.iso.torrent")))
+        };
+
+        var managers = await _client.AttachTorrentsAsync(torrents, _tempSavePath).WaitAsync(TimeSpan.FromSeconds(30));
+
+        try
+        {
+            Assert.Equal(torrents.Length, managers.Length);
+
+            for (var i = 0; i < torrents.Length; i++)
+            {
+                Assert.Same(torrents[i], managers[i].Info);
+                Assert.Contains(managers[i], _client.ActiveTorrents);
+            }
+        }
+        finally
+        {
+            foreach (var manager in managers)
+            {
+                await PerformCleanup(manager);
+            }
+        }
+    }
+
+    [Fact]
+    public async Task TestBatchAttachCompletesOnDispose()
+    {
+        var client = new TorrentClient(new TorrentClientConfig());
+        var torrents = new[]
+        {
+            new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent"))),
+            new TorrentInfo(Path.GetFullPath(Path.Combine("files", "ubuntu-20.04.6-live-server-amd64.iso.torrent")))
+        };
+
+        var attachTask = client.AttachTorrentsAsync(torrents, _tempSavePath);
+        client.Dispose();
+
+        // any torrents not attached before the session went away are cancelled, rather than left waiting forever
+        var completed = await Task.WhenAny(attachTask, Task.Delay(TimeSpan.FromSeconds(30)));
+
+        Assert.Same(attachTask, completed);
+        Assert.True(attachTask.IsCompletedSuccessfully || attachTask.IsCanceled);
+    }
+
+    [Fact]
+    public async Task TestBatchAttachCancellation()
+    {
+        var torrents = new[]
+        {
+            new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")))
+        };
+
+        using var cts = new CancellationTokenSource();
+        var removedTask = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+
+        _client.AlertRaised += CheckAlert;
+        cts.Cancel();
+
+        try
+        {
+            await Assert.ThrowsAnyAsync<OperationCanceledException>(() => _client.AttachTorrentsAsync(torrents, _tempSavePath, cts.Token));
+
+            // the torrent is detached again once it's been added
+            await removedTask.Task.WaitAsync(TimeSpan.FromSeconds(30));
+            Assert.Empty(_client.ActiveTorrents);
+        }
+        finally
+        {
+            _client.AlertRaised -= CheckAlert;
+        }
+
+        void CheckAlert(object sender, SessionAlert alert)
+        {
+            if (alert is TorrentRemovedAlert)
+            {
+                removedTask.TrySetResult();
+            }
+        }
+    }
+
+    [Fact]
+    public async Task TestResumeData()
+    {
+        var torrentInfo = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var torrentManager = _client.AttachTorrent(torrentInfo, _tempSavePath);
+
+        var tcs = new TaskCompletionSource();
+
+        // only download the non-video files (< 10mb)
+        foreach (var file in torrentManager.Files.Where(x => x.Info.FileSize > 1e+7))
+        {
+            file.Priority = FileDownloadPriority.DoNotDownload;
+        }
+
+        long[] progress;
+        ResumeDataAlert resumeData;
+
+        try
+        {
+            torrentManager.Start();
+
+            await using (new Timer(CheckProgress, (torrentManager, tcs), TimeSpan.Zero, TimeSpan.FromSeconds(5)))
+            {
+                await tcs.Task.WaitAsync(TimeSpan.FromMinutes(2));
+            }
+
+            torrentManager.Stop();
+
+            progress = torrentManager.GetFileProgress(pieceGranularity: false);
+            resumeData = await RequestResumeData(torrentManager, ResumeDataFlags.FlushDiskCache);
+
+            Assert.Equal(0, resumeData.ErrorCode);
+            Assert.NotEmpty(resumeData.Data);
+        }
+        finally
+        {
+            await PerformCleanup(torrentManager);
+        }
+
+        var checkedFiles = false;
+        _client.AlertRaised += CheckAlert;
+
+        var resumedManager = _client.AttachTorrent(torrentInfo, _tempSavePath, resumeData.Data);
+
+        try
+        {
+            var deadline = DateTime.UtcNow.AddSeconds(30);
+
+            while (resumedManager.GetCurrentStatus().State is TorrentState.CheckingResume && DateTime.UtcNow < deadline)
+            {
+                await Task.Delay(50);
+            }
+
+            // the files on disk match the resume data, so nothing needs to be hashed again
+            Assert.False(checkedFiles);
+            Assert.NotEqual(TorrentState.CheckingFiles, resumedManager.GetCurrentStatus().State);
+            Assert.Equal(progress, resumedManager.GetFileProgress(pieceGranularity: false));
+
+            // once saved, the torrent is left out of saves that only include modified torrents
+            await RequestResumeData(resumedManager, ResumeDataFlags.None);
+
+            Assert.Equal(0, _client.SaveAllResumeData(ResumeDataFlags.OnlyIfModified));
+            Assert.Equal(1, _client.SaveAllResumeData(ResumeDataFlags.None));
+        }
+        finally
+        {
+            _client.AlertRaised -= CheckAlert;
+            await PerformCleanup(resumedManager);
+        }
+
+        void CheckAlert(object sender, SessionAlert alert)
+        {
+            if (alert is TorrentStatusAlert { NewState: TorrentState.CheckingFiles } statusAlert && statusAlert.Subject?.Info == torrentInfo)
+            {
+                checkedFiles = true;
+            }
+        }
+    }
+
+    [Fact]
+    public void TestSessionStateRestore()
+    {
+        var state = _client.SaveState();
+        Assert.NotEmpty(state);
+
+        using var restoredClient = new TorrentClient(new TorrentClientConfig(), state);
+        Assert.NotEmpty(restoredClient.SaveState());
+
+        // invalid state should be rejected rather than silently ignored
+        Assert.Throws<InvalidOperationException>(() => new TorrentClient(new TorrentClientConfig(), [1, 2, 3]));
+    }
+
+    [Fact]
+    public async Task TestSessionStats()
+    {
+        var statsTask = new TaskCompletionSource<SessionStatsAlert>();
+        EventHandler<SessionAlert> handler = (_, alert) =>
+        {
+            if (alert is SessionStatsAlert statsAlert)
+            {
+                statsTask.TrySetResult(statsAlert);
+            }
+        };
+
+        _client.AlertRaised += handler;
+
+        try
+        {
+            _client.RequestSessionStats();
+            var stats = await statsTask.Task.WaitAsync(TimeSpan.FromSeconds(30));
+
+            // every metric should map to a counter in the snapshot
+            Assert.NotEmpty(SessionStatsAlert.Metrics);
+            Assert.True(SessionStatsAlert.Metrics.Values.All(x => x.Index < stats.Counters.Length));
+        }
+        finally
+        {
+            _client.AlertRaised -= handler;
+        }
+    }
+
+    [Fact]
+    public async Task TestCachedMagnetAttach()
+    {
+        const string infoHash = "dd8255ecdc7ca55fb0bbf81323d87062db1f6d1c";
+
+        var cachePath = Path.Combine(_tempSavePath, "metadata");
+
+        Directory.CreateDirectory(cachePath);
+        File.Copy(Path.Combine("files", "big-buck-bunny.torrent"), Path.Combine(cachePath, $"{infoHash}.torrent"));
+
+        _client.MetadataCachePath = cachePath;
+
+        // the metadata is cached, so there's no need to wait for peers
+        var attachTask = _client.AttachMagnetAsync($"magnet:?xt=urn:btih:{infoHash}", _tempSavePath);
+        Assert.True(attachTask.IsCompletedSuccessfully);
+
+        var torrentManager = await attachTask;
+
+        try
+        {
+            Assert.Equal(infoHash, torrentManager.Info.Metadata.InfoHash, ignoreCase: true);
+            Assert.NotEmpty(torrentManager.Files);
+        }
+        finally
+        {
+            await PerformCleanup(torrentManager);
+        }
+    }
+
+    [Fact]
+    public async Task TestMagnetMetadataCaching()
+    {
+        const string infoHash = "dd8255ecdc7ca55fb0bbf81323d87062db1f6d1c";
+
+        var cachePath = Path.Combine(_tempSavePath, "metadata");
+
+        using var seedClient = new TorrentClient(new TorrentClientConfig());
+        using var leechClient = new TorrentClient(new TorrentClientConfig());
+
+        leechClient.MetadataCachePath = cachePath;
+
+        // the seed only needs the metadata to hand it out, so none of the files are downloaded
+        var seedManager = seedClient.AttachTorrent(new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent"))), Path.Combine(_tempSavePath, "seed"));
+
+        foreach (var file in seedManager.Files)
+        {
+            file.Priority = FileDownloadPriority.DoNotDownload;
+        }
+
+        seedManager.Start();
+
+        var attachTask = leechClient.AttachMagnetAsync($"magnet:?xt=urn:btih:{infoHash}", Path.Combine(_tempSavePath, "leech"));
+        var deadline = DateTime.UtcNow.AddMinutes(1);
+
+        // keep connecting the seed to the leecher until the metadata has been exchanged
+        while (!attachTask.IsCompleted && DateTime.UtcNow < deadline)
+        {
+            if (leechClient.ListenPort > 0)
+            {
+                seedManager.ConnectPeer(new IPEndPoint(IPAddress.Loopback, leechClient.ListenPort));
+            }
+
+            await Task.WhenAny(attachTask, Task.Delay(TimeSpan.FromSeconds(2)));
+        }
+
+        var leechManager = await attachTask.WaitAsync(TimeSpan.Zero);
+        Assert.Equal(infoHash, leechManager.Info.Metadata.InfoHash, ignoreCase: true);
+
+        // the cache is written in the background once the metadata arrives
+        var cacheFile = Path.Combine(cachePath, $"{infoHash}.torrent");
+
+        while (!File.Exists(cacheFile) && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(100);
+        }
+
+        Assert.True(File.Exists(cacheFile));
+
+        // a new session pointed at the same cache doesn't need to wait for any peers
+        using var cachedClient = new TorrentClient(new TorrentClientConfig());
+        cachedClient.MetadataCachePath = cachePath;
+
+        var cachedTask = cachedClient.AttachMagnetAsync($"magnet:?xt=urn:btih:{infoHash}", Path.Combine(_tempSavePath, "cached"));
+
+        Assert.True(cachedTask.IsCompletedSuccessfully);
+        Assert.Equal(leechManager.Files.Count, (await cachedTask).Files.Count);
+    }
+
+    [Fact]
+    public async Task TestPeerSummaries()
+    {
+        var torrentPath = Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent"));
+
+        using var seedClient = new TorrentClient(new TorrentClientConfig());
+        using var leechClient = new TorrentClient(new TorrentClientConfig
+        {
+            AlertCategories = AlertCategories.Peer | AlertCategories.Connect
+        });
+
+        var summaries = new ConcurrentQueue<PeerSummaryAlert>();
+        leechClient.AlertRaised += (_, alert) =>
+        {
+            if (alert is PeerSummaryAlert summary)
+            {
+                summaries.Enqueue(summary);
+            }
+        };
+
+        leechClient.SetPeerAlertSummaries(TimeSpan.FromMilliseconds(250));
+
+        // neither side wants any data, so nothing is downloaded over the connection
+        var seedManager = seedClient.AttachTorrent(new TorrentInfo(torrentPath), Path.Combine(_tempSavePath, "seed"));
+        var leechManager = leechClient.AttachTorrent(new TorrentInfo(torrentPath), Path.Combine(_tempSavePath, "leech"));
+
+        foreach (var file in seedManager.Files.Concat(leechManager.Files))
+        {
+            file.Priority = FileDownloadPriority.DoNotDownload;
+        }
+
+        seedManager.Start();
+        leechManager.Start();
+
+        var deadline = DateTime.UtcNow.AddMinutes(1);
+
+        while (!summaries.Any(x => x.Counts[PeerAlertType.ConnectedIncoming] > 0) && DateTime.UtcNow < deadline)
+        {
+            if (leechClient.ListenPort > 0)
+            {
+                seedManager.ConnectPeer(new IPEndPoint(IPAddress.Loopback, leechClient.ListenPort));
+            }
+
+            await Task.Delay(TimeSpan.FromSeconds(1));
+        }
+
+        var connected = summaries.First(x => x.Counts[PeerAlertType.ConnectedIncoming] > 0);
+
+        Assert.Same(leechManager, connected.Subject);
+        Assert.Equal(TimeSpan.FromMilliseconds(250), connected.Window);
+        Assert.True(connected.UniqueEndpoints > 0);
+
+        // dropping the torrent on the seed closes the connection (if it wasn't already closed as redundant), which the leecher sees as an error
+        seedClient.DetachTorrent(seedManager);
+
+        while (!summaries.Any(x => x.Counts[PeerAlertType.Disconnected] > 0) && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(100);
+        }
+
+        var disconnected = summaries.First(x => x.Counts[PeerAlertType.Disconnected] > 0);
+
+        Assert.NotEmpty(disconnected.TopErrors);
+        Assert.All(disconnected.TopErrors, x =>
+        {
+            Assert.False(string.IsNullOrEmpty(x.Key.Category));
+            Assert.True(x.Value > 0);
+        });
+    }
+
+    private static async Task WaitForStatusUpdate(ConcurrentQueue<TorrentStatusUpdateAlert> updates, TorrentManager manager)
+    {
+        var deadline = DateTime.UtcNow.AddSeconds(30);
+
+        while (DateTime.UtcNow < deadline)
+        {
+            while (updates.TryDequeue(out var update))
+            {
+                if (update.Statuses.ContainsKey(manager))
+                {
+                    return;
+                }
+            }
+
+            await Task.Delay(50);
+        }
+
+        throw new TimeoutException("No status update was raised for the torrent.");
+    }
+
+    private async Task<PieceReadAlert> ReadPiece(TorrentManager manager, int pieceIndex)
+    {
+        var pieceTask = new TaskCompletionSource<PieceReadAlert>();
+
+        _client.AlertRaised += CheckAlert;
+
+        try
+        {
+            manager.ReadPiece(pieceIndex);
+            return await pieceTask.Task.WaitAsync(TimeSpan.FromSeconds(30));
+        }
+        finally
+        {
+            _client.AlertRaised -= CheckAlert;
+        }
+
+        void CheckAlert(object sender, SessionAlert alert)
+        {
+            if (alert is PieceReadAlert pieceAlert && ReferenceEquals(pieceAlert.Subject, manager) && pieceAlert.PieceIndex == pieceIndex)
+            {
+                pieceTask.TrySetResult(pieceAlert);
+            }
+        }
+    }
+
+    private async Task<ResumeDataAlert> RequestResumeData(TorrentManager manager, ResumeDataFlags flags)
+    {
+        var resumeTask = new TaskCompletionSource<ResumeDataAlert>();
+
+        _client.AlertRaised += CheckAlert;
+
+        try
+        {
+            manager.RequestResumeData(flags);
+            return await resumeTask.Task.WaitAsync(TimeSpan.FromSeconds(30));
+        }
+        finally
+        {
+            _client.AlertRaised -= CheckAlert;
+        }
+
+        void CheckAlert(object sender, SessionAlert alert)
+        {
+            if (alert is ResumeDataAlert resumeAlert && ReferenceEquals(resumeAlert.Subject, manager))
+            {
+                resumeTask.TrySetResult(resumeAlert);
+            }
+        }
+    }
+
     private void CheckProgress(object state)
     {
         var (manager, tcs) = (ValueTuple<TorrentManager, TaskCompletionSource>)state;
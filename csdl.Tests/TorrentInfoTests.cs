@@ -35,4 +35,16 @@ public class TorrentInfoTests
 
         Assert.True(fromFileNames.SetEquals(fromBytesNames));
     }
+
+    [Fact]
+    public void TestPagedFileList()
+    {
+        var torrent = new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent")));
+        var allFiles = torrent.Files.ToList();
+
+        // pages should line up with the full list, and be clamped to the files available
+        Assert.Equal(allFiles.Skip(1), torrent.GetFiles(1, 10));
+        Assert.Equal(allFiles.Take(1), torrent.GetFiles(0, 1));
+        Assert.Empty(torrent.GetFiles(allFiles.Count, 10));
+    }
 }
\ No newline at end of file
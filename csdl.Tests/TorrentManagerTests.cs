@@ -0,0 +1,114 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using csdl.Enums;
+using csdl.Native;
+using JetBrains.Annotations;
+
+namespace csdl.Tests;
+
+[TestSubject(typeof(TorrentManager))]
+public class TorrentManagerTests : IDisposable
+{
+    private const byte Sentinel = 0xCD;
+
+    private readonly TorrentClient _client = new(new TorrentClientConfig());
+    private readonly string _tempSavePath = Path.Combine(Path.GetTempPath(), "csdl-manager-test");
+    private readonly TorrentManager _manager;
+
+    public TorrentManagerTests()
+    {
+        _manager = _client.AttachTorrent(new TorrentInfo(Path.GetFullPath(Path.Combine("files", "big-buck-bunny.torrent"))), _tempSavePath);
+
+        // nothing in here needs any data
+        foreach (var file in _manager.Files)
+        {
+            file.Priority = FileDownloadPriority.DoNotDownload;
+        }
+    }
+
+    public void Dispose()
+    {
+        _client.Dispose();
+
+        if (Directory.Exists(_tempSavePath))
+        {
+            Directory.Delete(_tempSavePath, true);
+        }
+    }
+
+    [Fact]
+    public unsafe void TestExtendedStatusStructSize()
+    {
+        var fullSize = sizeof(NativeStructs.TorrentStatusEx);
+        var buffer = new byte[fullSize];
+
+        // an older caller that only knows about the basic status, but asks for everything
+        var olderSize = (int)Marshal.OffsetOf<NativeStructs.TorrentStatusEx>(nameof(NativeStructs.TorrentStatusEx.num_pieces));
+
+        fixed (byte* bufferPtr = buffer)
+        {
+            ref var status = ref *(NativeStructs.TorrentStatusEx*)bufferPtr;
+
+            // too small to hold the basic status, so nothing is written at all
+            Array.Fill(buffer, Sentinel);
+            status.struct_size = sizeof(int);
+
+            NativeMethods.GetTorrentStatusEx(_manager.TorrentSessionHandle, ref status);
+            Assert.All(buffer.Skip(sizeof(int)), x => Assert.Equal(Sentinel, x));
+
+            Array.Fill(buffer, Sentinel);
+            status.struct_size = olderSize;
+            status.fields = (TorrentStatusFields)uint.MaxValue;
+
+            NativeMethods.GetTorrentStatusEx(_manager.TorrentSessionHandle, ref status);
+
+            // the basic status is filled in, and everything past the caller's struct is left alone
+            Assert.Equal(olderSize, status.struct_size);
+            Assert.True(Enum.IsDefined(status.status.State));
+            Assert.All(buffer.Skip(olderSize), x => Assert.Equal(Sentinel, x));
+        }
+    }
+
+    [Fact]
+    public unsafe void TestExtendedStatusFields()
+    {
+        // optional fields are left unpopulated unless asked for
+        var basic = _manager.GetExtendedStatus();
+
+        Assert.Null(basic.Pieces);
+        Assert.Equal(-1, basic.DistributedCopies);
+
+        // a buffer too small for the bitfield is left untouched, and reports the size needed
+        var pieces = new byte[1];
+        Array.Fill(pieces, Sentinel);
+
+        var status = new NativeStructs.TorrentStatusEx
+        {
+            struct_size = sizeof(NativeStructs.TorrentStatusEx),
+            fields = TorrentStatusFields.Pieces
+        };
+
+        fixed (byte* piecesPtr = pieces)
+        {
+            status.pieces = (IntPtr)piecesPtr;
+            status.pieces_size = pieces.Length;
+
+            NativeMethods.GetTorrentStatusEx(_manager.TorrentSessionHandle, ref status);
+        }
+
+        Assert.Equal(Sentinel, pieces[0]);
+        Assert.True(status.pieces_count > 8);
+        Assert.Equal((status.pieces_count + 7) / 8, status.pieces_size);
+
+        // the managed wrapper grows its buffer to match
+        var full = _manager.GetExtendedStatus(TorrentStatusFields.Pieces);
+
+        Assert.NotNull(full.Pieces);
+        Assert.Equal(status.pieces_count, full.Pieces.Length);
+    }
+}
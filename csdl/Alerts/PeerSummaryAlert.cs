@@ -0,0 +1,63 @@
+﻿// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using csdl.Enums;
+using csdl.Native;
+
+namespace csdl.Alerts;
+
+/// <summary>
+/// Peer activity for a single torrent, aggregated over a fixed window.
+/// </summary>
+public class PeerSummaryAlert : SessionAlert
+{
+    internal PeerSummaryAlert(NativeEvents.PeerSummaryAlert alert, TorrentManager subject)
+        : base(alert.info)
+    {
+        Subject = subject;
+        Window = TimeSpan.FromMilliseconds(alert.window_ms);
+        UniqueEndpoints = alert.unique_endpoints;
+
+        var counts = new Dictionary<PeerAlertType, int>(alert.counts.Length);
+        var errors = new Dictionary<(string Category, int Code), int>(alert.top_error_codes.Length);
+
+        for (var i = 0; i < alert.counts.Length; i++)
+        {
+            counts[(PeerAlertType)i] = alert.counts[i];
+        }
+
+        for (var i = 0; i < alert.top_error_codes.Length && alert.top_error_counts[i] > 0; i++)
+        {
+            var category = Marshal.PtrToStringUTF8(alert.top_error_categories[i]) ?? string.Empty;
+            errors[(category, alert.top_error_codes[i])] = alert.top_error_counts[i];
+        }
+
+        Counts = counts;
+        TopErrors = errors;
+    }
+
+    public TorrentManager Subject { get; }
+
+    /// <summary>
+    /// The length of time the summary covers.
+    /// </summary>
+    public TimeSpan Window { get; }
+
+    /// <summary>
+    /// The number of peer events raised in the window, by type.
+    /// </summary>
+    public IReadOnlyDictionary<PeerAlertType, int> Counts { get; }
+
+    /// <summary>
+    /// The number of distinct peer endpoints seen in the window.
+    /// </summary>
+    public int UniqueEndpoints { get; }
+
+    /// <summary>
+    /// The most frequent disconnect/error codes raised in the window, keyed by error category and code, mapped to the number of times they occurred.
+    /// </summary>
+    public IReadOnlyDictionary<(string Category, int Code), int> TopErrors { get; }
+}
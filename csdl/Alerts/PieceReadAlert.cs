@@ -0,0 +1,44 @@
+﻿// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using csdl.Native;
+
+namespace csdl.Alerts;
+
+/// <summary>
+/// A piece read back from disk, requested by <see cref="TorrentManager.ReadPiece"/>.
+/// </summary>
+public class PieceReadAlert : SessionAlert
+{
+    internal PieceReadAlert(NativeEvents.PieceReadAlert alert, TorrentManager subject)
+        : base(alert.info)
+    {
+        Subject = subject;
+        PieceIndex = alert.piece;
+        ErrorCode = alert.error_code;
+
+        if (alert.buffer != IntPtr.Zero)
+        {
+            Buffer = new PieceBuffer(NativeMethods.CopyPieceBuffer(alert.buffer), alert.data, alert.size);
+        }
+    }
+
+    public TorrentManager Subject { get; }
+
+    /// <summary>
+    /// The index of the piece that was read.
+    /// </summary>
+    public int PieceIndex { get; }
+
+    /// <summary>
+    /// The contents of the piece, or null if it couldn't be read.
+    /// Should be disposed once no longer needed.
+    /// </summary>
+    public PieceBuffer Buffer { get; }
+
+    /// <summary>
+    /// The reason the piece couldn't be read, or zero if it was successful.
+    /// </summary>
+    public int ErrorCode { get; }
+}
@@ -0,0 +1,39 @@
+﻿// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using System.Runtime.InteropServices;
+using csdl.Native;
+
+namespace csdl.Alerts;
+
+/// <summary>
+/// Resume data generated for a torrent, which can be passed back when attaching the torrent to skip rechecking existing files.
+/// </summary>
+public class ResumeDataAlert : SessionAlert
+{
+    internal ResumeDataAlert(NativeEvents.ResumeDataAlert alert, TorrentManager subject)
+        : base(alert.info)
+    {
+        Subject = subject;
+        ErrorCode = alert.error_code;
+
+        if (alert.data != IntPtr.Zero)
+        {
+            Data = new byte[alert.length];
+            Marshal.Copy(alert.data, Data, 0, alert.length);
+        }
+    }
+
+    public TorrentManager Subject { get; }
+
+    /// <summary>
+    /// The resume data, or null if it couldn't be generated.
+    /// </summary>
+    public byte[] Data { get; }
+
+    /// <summary>
+    /// The reason the resume data couldn't be generated, or zero if it was successful.
+    /// </summary>
+    public int ErrorCode { get; }
+}
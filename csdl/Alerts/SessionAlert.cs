@@ -23,5 +23,8 @@ public class SessionAlert : EventArgs
 
     public DateTimeOffset Timestamp { get; }
 
+    /// <summary>
+    /// The human-readable message for the alert, or <c>null</c> if <see cref="TorrentClient.IncludeAlertMessages"/> is disabled.
+    /// </summary>
     public string Message { get; }
 }
\ No newline at end of file
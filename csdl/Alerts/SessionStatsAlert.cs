@@ -0,0 +1,59 @@
+﻿// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using csdl.Enums;
+using csdl.Native;
+
+namespace csdl.Alerts;
+
+/// <summary>
+/// Describes a single performance counter in a <see cref="SessionStatsAlert"/>.
+/// </summary>
+/// <param name="Name">The libtorrent name of the metric, e.g. <c>disk.queued_disk_jobs</c></param>
+/// <param name="Index">The index of the metric's value in <see cref="SessionStatsAlert.Counters"/></param>
+/// <param name="Type">Whether the metric is a counter or a gauge</param>
+public record SessionStatsMetric(string Name, int Index, StatsMetricType Type);
+
+/// <summary>
+/// A snapshot of the session's performance counters, requested by <see cref="TorrentClient.RequestSessionStats"/>.
+/// </summary>
+public class SessionStatsAlert : SessionAlert
+{
+    private static readonly Lazy<IReadOnlyDictionary<string, SessionStatsMetric>> MetricTable = new(LoadMetrics);
+
+    internal SessionStatsAlert(NativeEvents.SessionStatsAlert alert)
+        : base(alert.info)
+    {
+        Counters = new long[alert.count];
+        Marshal.Copy(alert.counters, Counters, 0, alert.count);
+    }
+
+    /// <summary>
+    /// Gets the metrics describing each value in <see cref="Counters"/>, keyed by name.
+    /// </summary>
+    public static IReadOnlyDictionary<string, SessionStatsMetric> Metrics => MetricTable.Value;
+
+    /// <summary>
+    /// The raw counter values, indexed by <see cref="SessionStatsMetric.Index"/>.
+    /// </summary>
+    public long[] Counters { get; }
+
+    /// <summary>
+    /// Gets the value of a metric by name.
+    /// </summary>
+    /// <param name="metricName">The name of the metric (see <see cref="Metrics"/>)</param>
+    /// <exception cref="KeyNotFoundException">The metric does not exist</exception>
+    public long GetValue(string metricName) => Counters[Metrics[metricName].Index];
+
+    private static unsafe IReadOnlyDictionary<string, SessionStatsMetric> LoadMetrics()
+    {
+        var count = NativeMethods.GetSessionStatsMetrics(out var metricsPtr);
+        var metrics = new ReadOnlySpan<NativeStructs.SessionStatsMetric>(metricsPtr.ToPointer(), count).ToArray();
+
+        return metrics.Select(x => new SessionStatsMetric(Marshal.PtrToStringUTF8(x.name), x.value_index, x.type)).ToDictionary(x => x.Name);
+    }
+}
@@ -0,0 +1,24 @@
+﻿// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System.Collections.Generic;
+using csdl.Native;
+
+namespace csdl.Alerts;
+
+/// <summary>
+/// Periodic update containing the status of every torrent that changed since the previous update.
+/// </summary>
+public class TorrentStatusUpdateAlert : SessionAlert
+{
+    internal TorrentStatusUpdateAlert(NativeEvents.TorrentStatusUpdateAlert alert, IReadOnlyDictionary<TorrentManager, TorrentStatus> statuses)
+        : base(alert.info)
+    {
+        Statuses = statuses;
+    }
+
+    /// <summary>
+    /// The latest status of each torrent that changed.
+    /// </summary>
+    public IReadOnlyDictionary<TorrentManager, TorrentStatus> Statuses { get; }
+}
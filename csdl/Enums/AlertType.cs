@@ -9,5 +9,12 @@ public enum AlertType
     TorrentStatus = 1,
     ClientPerformance = 2,
     Peer = 3,
-    TorrentRemoved = 4
+    TorrentRemoved = 4,
+    PeerSummary = 5,
+    TorrentStatusUpdates = 6,
+    TorrentAdded = 7,
+    ResumeData = 8,
+    MetadataReceived = 9,
+    PieceRead = 10,
+    SessionStats = 11
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+namespace csdl.Enums;
+
+/// <summary>
+/// Native calls tracked when <see cref="NativeMetrics.Enabled"/> is set.
+/// </summary>
+public enum NativeMetric
+{
+    CreateSession = 0,
+    AttachTorrent = 1,
+    AttachTorrentsAsync = 2,
+    AttachMagnet = 3,
+    DetachTorrent = 4,
+    GetTorrentStatus = 5,
+    GetTorrentStatusEx = 6,
+    GetAllTorrentStatus = 7,
+    SaveAllResumeData = 8,
+    GetTorrentFileList = 9,
+    GetFileProgress = 10,
+    GetFilePriorities = 11,
+    SetFilePriorities = 12,
+    PollAlerts = 13,
+
+    /// <summary>
+    /// Time spent draining and delivering a batch of alerts.
+    /// </summary>
+    AlertDrain = 14,
+
+    /// <summary>
+    /// The number of alerts processed per drain. Values are alert counts rather than nanoseconds.
+    /// </summary>
+    AlertDrainSize = 15
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+
+namespace csdl.Enums;
+
+/// <summary>
+/// Options used when requesting resume data.
+/// </summary>
+[Flags]
+public enum ResumeDataFlags : uint
+{
+    None = 0,
+
+    /// <summary>
+    /// Flush the disk cache before saving, ensuring the resume data reflects everything written so far.
+    /// </summary>
+    FlushDiskCache = 1 << 0,
+
+    /// <summary>
+    /// Include the torrent metadata, allowing the torrent to be attached from the resume data alone.
+    /// </summary>
+    SaveInfoDict = 1 << 1,
+
+    /// <summary>
+    /// Skip torrents that haven't changed since their resume data was last saved.
+    /// </summary>
+    OnlyIfModified = 1 << 2
+}
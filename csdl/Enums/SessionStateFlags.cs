@@ -0,0 +1,25 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+
+namespace csdl.Enums;
+
+/// <summary>
+/// The parts of a session's state to save or restore.
+/// </summary>
+[Flags]
+public enum SessionStateFlags : uint
+{
+    None = 0,
+
+    Settings = 1 << 0,
+
+    /// <summary>
+    /// The DHT routing table and node id, allowing the DHT to be used straight away instead of bootstrapping from scratch.
+    /// </summary>
+    Dht = 1 << 1,
+
+    Extensions = 1 << 2,
+    IPFilter = 1 << 3
+}
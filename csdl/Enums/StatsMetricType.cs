@@ -0,0 +1,17 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+namespace csdl.Enums;
+
+public enum StatsMetricType
+{
+    /// <summary>
+    /// A value that only ever increases, such as the total bytes downloaded.
+    /// </summary>
+    Counter = 0,
+
+    /// <summary>
+    /// A value that can rise and fall, such as the number of connected peers.
+    /// </summary>
+    Gauge = 1
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+
+namespace csdl.Enums;
+
+/// <summary>
+/// Optional parts of an <see cref="ExtendedTorrentStatus"/> that are more expensive to collect, and are only populated when requested.
+/// </summary>
+[Flags]
+public enum TorrentStatusFields : uint
+{
+    None = 0,
+
+    DistributedCopies = 1 << 0,
+    AccurateCounters = 1 << 1,
+    LastSeenComplete = 1 << 2,
+    Pieces = 1 << 3
+}
@@ -0,0 +1,144 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using System.Collections;
+using csdl.Enums;
+using csdl.Native;
+
+namespace csdl;
+
+/// <summary>
+/// Contains the current state of an attached torrent, with additional information useful for queueing and scheduling.
+/// </summary>
+public class ExtendedTorrentStatus
+{
+    internal ExtendedTorrentStatus(in NativeStructs.TorrentStatusEx status, BitArray pieces)
+    {
+        Status = status.status;
+
+        PieceCount = status.num_pieces;
+        QueuePosition = status.queue_position;
+
+        TotalWanted = status.total_wanted;
+        TotalWantedDone = status.total_wanted_done;
+        TotalDone = status.total_done;
+
+        DistributedCopies = status.distributed_copies;
+
+        KnownPeers = status.list_peers;
+        KnownSeeds = status.list_seeds;
+        ConnectCandidates = status.connect_candidates;
+        ConnectionCount = status.num_connections;
+
+        ScrapeCompleteCount = status.num_complete;
+        ScrapeIncompleteCount = status.num_incomplete;
+
+        NextAnnounce = TimeSpan.FromSeconds(status.next_announce);
+        ActiveTime = TimeSpan.FromSeconds(status.active_time);
+        FinishedTime = TimeSpan.FromSeconds(status.finished_time);
+        SeedingTime = TimeSpan.FromSeconds(status.seeding_time);
+
+        LastSeenComplete = status.last_seen_complete > 0 ? DateTimeOffset.FromUnixTimeSeconds(status.last_seen_complete) : null;
+        Pieces = pieces;
+    }
+
+    /// <summary>
+    /// The basic status, as returned by <see cref="TorrentManager.GetCurrentStatus"/>.
+    /// </summary>
+    public TorrentStatus Status { get; }
+
+    /// <summary>
+    /// The number of pieces that have been downloaded.
+    /// </summary>
+    public int PieceCount { get; }
+
+    /// <summary>
+    /// The position of the torrent in the download queue, or -1 if it isn't queued (i.e. seeding or finished).
+    /// </summary>
+    public int QueuePosition { get; }
+
+    /// <summary>
+    /// The number of bytes that need downloading, excluding files with a priority of <see cref="FileDownloadPriority.DoNotDownload"/>.
+    /// </summary>
+    public long TotalWanted { get; }
+
+    /// <summary>
+    /// The number of bytes of <see cref="TotalWanted"/> that have been downloaded.
+    /// </summary>
+    public long TotalWantedDone { get; }
+
+    /// <summary>
+    /// The number of bytes downloaded, including unwanted files.
+    /// Only updated periodically unless <see cref="TorrentStatusFields.AccurateCounters"/> was requested.
+    /// </summary>
+    public long TotalDone { get; }
+
+    /// <summary>
+    /// The number of distributed copies of the torrent among connected peers.
+    /// Only populated if <see cref="TorrentStatusFields.DistributedCopies"/> was requested, otherwise -1.
+    /// </summary>
+    public float DistributedCopies { get; }
+
+    /// <summary>
+    /// The number of peers the torrent knows about, whether connected or not.
+    /// </summary>
+    public int KnownPeers { get; }
+
+    /// <summary>
+    /// The number of seeds the torrent knows about, whether connected or not.
+    /// </summary>
+    public int KnownSeeds { get; }
+
+    /// <summary>
+    /// The number of known peers that are eligible to be connected to.
+    /// </summary>
+    public int ConnectCandidates { get; }
+
+    /// <summary>
+    /// The number of open connections, including half-open ones.
+    /// </summary>
+    public int ConnectionCount { get; }
+
+    /// <summary>
+    /// The number of seeds reported by the tracker, or -1 if unknown.
+    /// </summary>
+    public int ScrapeCompleteCount { get; }
+
+    /// <summary>
+    /// The number of downloaders reported by the tracker, or -1 if unknown.
+    /// </summary>
+    public int ScrapeIncompleteCount { get; }
+
+    /// <summary>
+    /// The time until the next tracker announcement.
+    /// </summary>
+    public TimeSpan NextAnnounce { get; }
+
+    /// <summary>
+    /// The total time the torrent has been active (not paused).
+    /// </summary>
+    public TimeSpan ActiveTime { get; }
+
+    /// <summary>
+    /// The total time the torrent has been finished.
+    /// </summary>
+    public TimeSpan FinishedTime { get; }
+
+    /// <summary>
+    /// The total time the torrent has been seeding.
+    /// </summary>
+    public TimeSpan SeedingTime { get; }
+
+    /// <summary>
+    /// The last time a peer with the complete torrent was seen.
+    /// Only populated if <see cref="TorrentStatusFields.LastSeenComplete"/> was requested.
+    /// </summary>
+    public DateTimeOffset? LastSeenComplete { get; }
+
+    /// <summary>
+    /// The pieces that have been downloaded, indexed by piece.
+    /// Only populated if <see cref="TorrentStatusFields.Pieces"/> was requested.
+    /// </summary>
+    public BitArray Pieces { get; }
+}
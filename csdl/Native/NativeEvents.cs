@@ -9,6 +9,53 @@ namespace csdl.Native;
 
 internal static class NativeEvents
 {
+    /// <summary>
+    /// Flags controlling how events are delivered from the native library.
+    /// </summary>
+    [Flags]
+    public enum EventFlags : uint
+    {
+        None = 0,
+
+        /// <summary>
+        /// Deliver events that aren't mapped, which only produce <see cref="AlertBase"/> values with no additional data.
+        /// </summary>
+        IncludeUnmapped = 1 << 0,
+
+        /// <summary>
+        /// Populate <see cref="AlertBase.message"/>. Messages are left as <c>null</c> unless requested.
+        /// </summary>
+        FormatMessages = 1 << 1
+    }
+
+    /// <summary>
+    /// Native-side alert filter, applied before any alert structure is created.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct AlertFilter
+    {
+        /// <summary>
+        /// Bitmask of <c>1 &lt;&lt; <see cref="AlertType"/></c> values to deliver
+        /// </summary>
+        public uint alert_types;
+
+        /// <summary>
+        /// Bitmask of <c>1 &lt;&lt; <see cref="PeerAlertType"/></c> values to deliver
+        /// </summary>
+        public uint peer_alert_types;
+
+        /// <summary>
+        /// <see cref="AlertCategories"/> to deliver, or -1 to allow all
+        /// </summary>
+        public int category_mask;
+
+        /// <summary>
+        /// The number of 20-byte info hashes pointed to by <see cref="info_hashes"/>, or zero to allow all torrents
+        /// </summary>
+        public int info_hash_count;
+        public IntPtr info_hashes;
+    }
+
     [StructLayout(LayoutKind.Sequential, Pack = 8)]
     public struct AlertBase
     {
@@ -69,4 +116,114 @@ internal static class NativeEvents
         [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)]
         public byte[] v6_address;
     }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct PeerSummaryAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public byte[] info_hash;
+
+        public int window_ms;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 7)]
+        public int[] counts;
+
+        public int unique_endpoints;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
+        public int[] top_error_codes;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
+        public int[] top_error_counts;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 4)]
+        public IntPtr[] top_error_categories;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct TorrentStatusUpdateAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        public int count;
+        public IntPtr statuses;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct TorrentAddedAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        public long request_id;
+
+        public IntPtr handle;
+        public int error_code;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public byte[] info_hash;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct ResumeDataAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        public IntPtr handle;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public byte[] info_hash;
+
+        public IntPtr data;
+        public int length;
+
+        public int error_code;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct MetadataReceivedAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        public IntPtr handle;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public byte[] info_hash;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct PieceReadAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        public IntPtr handle;
+
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public byte[] info_hash;
+
+        public int piece;
+        public int size;
+
+        public IntPtr data;
+        public IntPtr buffer;
+
+        public int error_code;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct SessionStatsAlert
+    {
+        [MarshalAs(UnmanagedType.Struct)]
+        public AlertBase info;
+
+        public int count;
+        public IntPtr counters;
+    }
 }
\ No newline at end of file
@@ -17,6 +17,15 @@ internal static partial class NativeMethods
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate void SessionEventCallback(IntPtr alertPtr);
 
+    /// <summary>
+    /// Delegate representing the batched callback for session events.
+    /// </summary>
+    /// <param name="alertsPtr">Pointer to the first record in the batch</param>
+    /// <param name="count">The number of records in the batch</param>
+    /// <param name="recordSize">The size of each record, in bytes</param>
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void SessionEventBatchCallback(IntPtr alertsPtr, int count, int recordSize);
+
     /// <summary>
     /// Creates a session, optionally using a provided settings pack.
     /// </summary>
@@ -25,6 +34,33 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "create_session")]
     public static unsafe partial IntPtr CreateSession(void* settingsPack);
 
+    /// <summary>
+    /// Creates a session, restoring state saved by <see cref="SaveSessionState"/>.
+    /// </summary>
+    /// <param name="state">The saved session state</param>
+    /// <param name="length">The length of <see cref="state"/></param>
+    /// <param name="flags">The parts of the saved state to restore</param>
+    /// <param name="settingsPack">A settings pack handle, replacing any saved settings. Set to <c>null</c> to use the saved settings</param>
+    /// <returns>A handle to the session, or <see cref="IntPtr.Zero"/> if the state was invalid</returns>
+    [LibraryImport(LibraryName, EntryPoint = "create_session_from_state")]
+    public static unsafe partial IntPtr CreateSessionFromState(byte[] state, int length, SessionStateFlags flags, void* settingsPack);
+
+    /// <summary>
+    /// Serializes the state of a session, allowing a future session to be restored from it.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to save</param>
+    /// <param name="flags">The parts of the session state to save</param>
+    /// <param name="state">Location of the <see cref="NativeStructs.SessionState"/> to populate</param>
+    [LibraryImport(LibraryName, EntryPoint = "save_session_state")]
+    public static partial void SaveSessionState(IntPtr sessionHandle, SessionStateFlags flags, out NativeStructs.SessionState state);
+
+    /// <summary>
+    /// Release the unmanaged resources associated with a <see cref="state"/>.
+    /// </summary>
+    /// <param name="state">The session state to release</param>
+    [LibraryImport(LibraryName, EntryPoint = "destroy_session_state")]
+    public static partial void FreeSessionState(ref NativeStructs.SessionState state);
+
     /// <summary>
     /// Releases the unmanaged resources associated with a session.
     /// </summary>
@@ -37,9 +73,18 @@ internal static partial class NativeMethods
     /// </summary>
     /// <param name="sessionHandle">The handle for the session to add the callback to</param>
     /// <param name="callback">The callback to run when an event is posted</param>
-    /// <param name="includeUnmappedEvents">Whether to run the <see cref="callback"/> for events that aren't mapped, that only produce <see cref="NativeEvents.AlertBase"/> values with no additional data</param>
+    /// <param name="flags">Flags controlling which events are delivered, and whether messages are formatted</param>
     [LibraryImport(LibraryName, EntryPoint = "set_event_callback")]
-    public static partial void SetEventCallback(IntPtr sessionHandle, [MarshalAs(UnmanagedType.FunctionPtr)] SessionEventCallback callback, [MarshalAs(UnmanagedType.Bool)] bool includeUnmappedEvents);
+    public static partial void SetEventCallback(IntPtr sessionHandle, [MarshalAs(UnmanagedType.FunctionPtr)] SessionEventCallback callback, NativeEvents.EventFlags flags);
+
+    /// <summary>
+    /// Sets the batched event callback for a session, replacing any callback set with <see cref="SetEventCallback"/>.
+    /// </summary>
+    /// <param name="sessionHandle">The handle for the session to add the callback to</param>
+    /// <param name="callback">The callback to run when a batch of events has been posted</param>
+    /// <param name="flags">Flags controlling which events are delivered, and whether messages are formatted</param>
+    [LibraryImport(LibraryName, EntryPoint = "set_event_batch_callback")]
+    public static partial void SetEventBatchCallback(IntPtr sessionHandle, [MarshalAs(UnmanagedType.FunctionPtr)] SessionEventBatchCallback callback, NativeEvents.EventFlags flags);
 
     /// <summary>
     /// Clears the currently set event callback.
@@ -48,6 +93,106 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "clear_event_callback")]
     public static partial void ClearEventCallback(IntPtr sessionHandle);
 
+    /// <summary>
+    /// Switches event delivery to a fixed-size queue, collected by calling <see cref="PollAlerts"/>.
+    /// </summary>
+    /// <param name="sessionHandle">The handle for the session to enable polling on</param>
+    /// <param name="capacity">The number of events that can be queued before new ones are dropped. Only the first call sets the capacity</param>
+    /// <param name="flags">Flags controlling which events are queued, and whether messages are formatted</param>
+    [LibraryImport(LibraryName, EntryPoint = "set_event_polling")]
+    public static partial void SetEventPolling(IntPtr sessionHandle, int capacity, NativeEvents.EventFlags flags);
+
+    /// <summary>
+    /// Copies queued events into a caller-provided buffer.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to poll</param>
+    /// <param name="buffer">Pointer to a buffer of at least <see cref="max"/> event records</param>
+    /// <param name="max">The maximum number of records to copy</param>
+    /// <returns>The number of records written</returns>
+    /// <remarks>Records (and any strings they point to) remain valid until the next call. Only one thread may poll a session at a time.</remarks>
+    [LibraryImport(LibraryName, EntryPoint = "poll_alerts")]
+    public static partial int PollAlerts(IntPtr sessionHandle, IntPtr buffer, int max);
+
+    /// <summary>
+    /// Gets the number of events discarded because the polling queue was full.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle</param>
+    [LibraryImport(LibraryName, EntryPoint = "get_dropped_alert_count")]
+    public static partial long GetDroppedAlertCount(IntPtr sessionHandle);
+
+    /// <summary>
+    /// Sets a filter applied to events before they are delivered, narrowing the session's alert mask to match.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to apply the filter to</param>
+    /// <param name="filter">The filter to apply</param>
+    [LibraryImport(LibraryName, EntryPoint = "set_alert_filter")]
+    public static partial void SetAlertFilter(IntPtr sessionHandle, in NativeEvents.AlertFilter filter);
+
+    /// <summary>
+    /// Removes the event filter, restoring the alert mask in place before it was set.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to remove the filter from</param>
+    public static void ClearAlertFilter(IntPtr sessionHandle) => SetAlertFilter(sessionHandle, IntPtr.Zero);
+
+    [LibraryImport(LibraryName, EntryPoint = "set_alert_filter")]
+    private static partial void SetAlertFilter(IntPtr sessionHandle, IntPtr filter);
+
+    /// <summary>
+    /// Folds peer events into a single summary per torrent, emitted every <see cref="windowMs"/> milliseconds.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to configure</param>
+    /// <param name="windowMs">The length of each summary window, in milliseconds. Set to zero to disable aggregation</param>
+    /// <param name="includeRawAlerts">Whether individual peer events should still be delivered</param>
+    [LibraryImport(LibraryName, EntryPoint = "set_peer_alert_aggregation")]
+    public static partial void SetPeerAlertAggregation(IntPtr sessionHandle, int windowMs, [MarshalAs(UnmanagedType.I1)] bool includeRawAlerts);
+
+    /// <summary>
+    /// Sets how often the session should raise an event listing the torrents whose status has changed.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to configure</param>
+    /// <param name="intervalMs">The time between updates, in milliseconds. Set to zero to disable updates</param>
+    [LibraryImport(LibraryName, EntryPoint = "set_status_update_interval")]
+    public static partial void SetStatusUpdateInterval(IntPtr sessionHandle, int intervalMs);
+
+    /// <summary>
+    /// Gets counters for the thread responsible for draining and dispatching session events.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to get the counters for</param>
+    /// <param name="stats">Variable to populate with the current counters</param>
+    [LibraryImport(LibraryName, EntryPoint = "get_alert_pump_stats")]
+    public static partial void GetAlertPumpStats(IntPtr sessionHandle, out NativeStructs.AlertPumpStats stats);
+
+    /// <summary>
+    /// Requests a snapshot of the session's performance counters, raised as a <see cref="NativeEvents.SessionStatsAlert"/>.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to get the counters for</param>
+    [LibraryImport(LibraryName, EntryPoint = "post_session_stats")]
+    public static partial void PostSessionStats(IntPtr sessionHandle);
+
+    /// <summary>
+    /// Gets the table describing each performance counter. The table is static, and must not be freed.
+    /// </summary>
+    /// <param name="metrics">Variable to populate with a pointer to the first <see cref="NativeStructs.SessionStatsMetric"/></param>
+    /// <returns>The number of metrics in the table</returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_session_stats_metrics")]
+    public static partial int GetSessionStatsMetrics(out IntPtr metrics);
+
+    /// <summary>
+    /// Enables or disables latency tracking for instrumented native calls.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "set_native_metrics_enabled")]
+    public static partial void SetNativeMetricsEnabled([MarshalAs(UnmanagedType.I1)] bool enabled);
+
+    /// <summary>
+    /// Gets the histogram for an instrumented native call, summed across all threads.
+    /// </summary>
+    /// <param name="metric">The metric to get</param>
+    /// <param name="histogram">Variable to populate with the histogram</param>
+    /// <returns>Whether the metric exists</returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_native_metrics")]
+    [return: MarshalAs(UnmanagedType.I1)]
+    public static partial bool GetNativeMetrics(NativeMetric metric, out NativeStructs.NativeHistogram histogram);
+
     /// <summary>
     /// Applies a settings pack to a session.
     /// </summary>
@@ -56,6 +201,14 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "apply_settings")]
     public static partial void ApplySettingsPack(IntPtr sessionHandle, IntPtr settingsPack);
 
+    /// <summary>
+    /// Gets the port a session is accepting connections on.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle</param>
+    /// <returns>The listening port, or 0 if the session isn't listening</returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_listen_port")]
+    public static partial int GetListenPort(IntPtr sessionHandle);
+
     /// <summary>
     /// Create a torrent from a file on the local disk
     /// </summary>
@@ -102,6 +255,68 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "attach_torrent", StringMarshalling = StringMarshalling.Utf8)]
     public static partial IntPtr AttachTorrent(IntPtr sessionHandle, IntPtr torrentHandle, [MarshalAs(UnmanagedType.LPUTF8Str)] string savePath);
 
+    /// <summary>
+    /// Attach a torrent to a session, restoring its state from previously saved resume data
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to attach the torrent to</param>
+    /// <param name="torrentHandle">The handle of the torrent to attach. Can be <see cref="IntPtr.Zero"/> if the resume data contains the torrent metadata</param>
+    /// <param name="savePath">The path to save the contents of the torrent to</param>
+    /// <param name="resumeData">Resume data produced by <see cref="SaveResumeData"/></param>
+    /// <param name="resumeDataLength">The length of <see cref="resumeData"/></param>
+    /// <returns>A torrent-session handle</returns>
+    [LibraryImport(LibraryName, EntryPoint = "attach_torrent_with_resume", StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr AttachTorrentWithResume(IntPtr sessionHandle, IntPtr torrentHandle, [MarshalAs(UnmanagedType.LPUTF8Str)] string savePath, byte[] resumeData, int resumeDataLength);
+
+    /// <summary>
+    /// Queues a batch of torrents to be attached to a session, without waiting for each one to be added.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to attach the torrents to</param>
+    /// <param name="requests">The torrents to attach. Each result is raised as a <see cref="NativeEvents.TorrentAddedAlert"/> with the matching request id</param>
+    /// <param name="count">The number of requests</param>
+    /// <returns>The number of torrents submitted</returns>
+    [LibraryImport(LibraryName, EntryPoint = "attach_torrents_async")]
+    public static unsafe partial int AttachTorrentsAsync(IntPtr sessionHandle, NativeStructs.AttachRequest* requests, int count);
+
+    /// <summary>
+    /// Copies a torrent-session handle owned by an event, so it remains valid after the event has been processed.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The handle to copy</param>
+    /// <returns>A torrent-session handle, released by <see cref="DetachTorrent"/></returns>
+    [LibraryImport(LibraryName, EntryPoint = "copy_torrent_handle")]
+    public static partial IntPtr CopyTorrentHandle(IntPtr torrentSessionHandle);
+
+    /// <summary>
+    /// Sets the directory metadata downloaded for magnet links is cached in.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to configure</param>
+    /// <param name="directory">The cache directory, or null to disable the cache</param>
+    [LibraryImport(LibraryName, EntryPoint = "set_metadata_cache_dir", StringMarshalling = StringMarshalling.Utf8)]
+    public static partial void SetMetadataCacheDir(IntPtr sessionHandle, [MarshalAs(UnmanagedType.LPUTF8Str)] string directory);
+
+    /// <summary>
+    /// Attaches a torrent from a magnet link. If the metadata isn't cached, a <see cref="NativeEvents.MetadataReceivedAlert"/> is raised once it has been downloaded.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to attach the torrent to</param>
+    /// <param name="magnetUri">The magnet link</param>
+    /// <param name="savePath">The path to save the downloaded files to</param>
+    /// <returns>A torrent-session handle, or <see cref="IntPtr.Zero"/> if the link was invalid or the torrent is already attached</returns>
+    [LibraryImport(LibraryName, EntryPoint = "attach_magnet", StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr AttachMagnet(IntPtr sessionHandle, [MarshalAs(UnmanagedType.LPUTF8Str)] string magnetUri, [MarshalAs(UnmanagedType.LPUTF8Str)] string savePath);
+
+    /// <summary>
+    /// Gets the metadata of an attached torrent.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent-session handle</param>
+    /// <returns>A torrent handle (released by <see cref="FreeTorrent"/>), or <see cref="IntPtr.Zero"/> if the metadata hasn't been downloaded yet</returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_torrent_handle_info")]
+    public static partial IntPtr GetTorrentHandleInfo(IntPtr torrentSessionHandle);
+
+    /// <summary>
+    /// Copies the v1 info hash of an attached torrent into a 20-byte buffer.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "get_torrent_info_hash")]
+    public static unsafe partial void GetTorrentInfoHash(IntPtr torrentSessionHandle, byte* infoHash);
+
     /// <summary>
     /// Detaches a torrent from a session, stopping the download.
     /// </summary>
@@ -137,6 +352,16 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "get_torrent_file_list")]
     public static partial void GetTorrentFileList(IntPtr torrentHandle, out NativeStructs.TorrentFileList files);
 
+    /// <summary>
+    /// Request a range of files contained within a torrent, allowing large file lists to be paged through.
+    /// </summary>
+    /// <param name="torrentHandle">Handle of the torrent file to get info for</param>
+    /// <param name="startIndex">The index of the first file to list</param>
+    /// <param name="count">The maximum number of files to list</param>
+    /// <param name="files">Location of the <see cref="NativeStructs.TorrentFileList"/> to populate</param>
+    [LibraryImport(LibraryName, EntryPoint = "get_torrent_file_list_range")]
+    public static partial void GetTorrentFileListRange(IntPtr torrentHandle, int startIndex, int count, out NativeStructs.TorrentFileList files);
+
     /// <summary>
     /// Release the unmanaged resources associated with a <see cref="files"/>.
     /// </summary>
@@ -161,6 +386,102 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "set_file_dl_priority")]
     public static partial void SetFilePriority(IntPtr torrentSessionHandle, int fileIndex, FileDownloadPriority priority);
 
+    /// <summary>
+    /// Gets the download priority of every file within a torrent.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="priorities">Buffer to copy the priorities into, indexed by file</param>
+    /// <param name="count">The length of <see cref="priorities"/></param>
+    /// <returns>The number of files in the torrent. If larger than <see cref="count"/>, only the first <see cref="count"/> priorities were copied</returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_file_priorities")]
+    public static unsafe partial int GetFilePriorities(IntPtr torrentSessionHandle, FileDownloadPriority* priorities, int count);
+
+    /// <summary>
+    /// Sets the download priority of every file within a torrent at once.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="priorities">The priorities to apply, indexed by file. Files past <see cref="count"/> are reset to <see cref="FileDownloadPriority.Normal"/></param>
+    /// <param name="count">The length of <see cref="priorities"/></param>
+    [LibraryImport(LibraryName, EntryPoint = "set_file_priorities")]
+    public static unsafe partial void SetFilePriorities(IntPtr torrentSessionHandle, FileDownloadPriority* priorities, int count);
+
+    /// <summary>
+    /// Sets the download priority of a subset of files within a torrent at once, leaving the rest unchanged.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="updates">The files to update, and their new priorities</param>
+    /// <param name="count">The length of <see cref="updates"/></param>
+    [LibraryImport(LibraryName, EntryPoint = "set_file_priorities_sparse")]
+    public static unsafe partial void SetFilePrioritiesSparse(IntPtr torrentSessionHandle, NativeStructs.FilePriorityUpdate* updates, int count);
+
+    /// <summary>
+    /// Requests a downloaded piece be read back from disk, raised as a <see cref="NativeEvents.PieceReadAlert"/> once complete.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="piece">The index of the piece to read</param>
+    [LibraryImport(LibraryName, EntryPoint = "read_piece")]
+    public static partial void ReadPiece(IntPtr torrentSessionHandle, int piece);
+
+    /// <summary>
+    /// Shares ownership of a piece buffer owned by an event, so its data remains valid after the event has been processed.
+    /// </summary>
+    /// <param name="buffer">The buffer to share</param>
+    /// <returns>A piece buffer handle, released by <see cref="ReleasePieceBuffer"/></returns>
+    [LibraryImport(LibraryName, EntryPoint = "copy_piece_buffer")]
+    public static partial IntPtr CopyPieceBuffer(IntPtr buffer);
+
+    /// <summary>
+    /// Releases a piece buffer handle created by <see cref="CopyPieceBuffer"/>.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "release_piece_buffer")]
+    public static partial void ReleasePieceBuffer(IntPtr buffer);
+
+    /// <summary>
+    /// Opens a read-ahead window over a file within a torrent, allowing it to be played back while downloading.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="fileIndex">The index of the file to stream</param>
+    /// <param name="readAheadBytes">How far ahead of the reader pieces should be prioritised</param>
+    /// <param name="deadlineStepMs">The gap between the deadlines of consecutive pieces in the window</param>
+    /// <returns>A stream handle (released by <see cref="CloseTorrentStream"/>), or <see cref="IntPtr.Zero"/> if the torrent has no metadata or the file doesn't exist</returns>
+    [LibraryImport(LibraryName, EntryPoint = "open_torrent_stream")]
+    public static partial IntPtr OpenTorrentStream(IntPtr torrentSessionHandle, int fileIndex, long readAheadBytes, int deadlineStepMs);
+
+    /// <summary>
+    /// Moves a stream's reader to a new position within the file, sliding the read-ahead window with it.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "seek_torrent_stream")]
+    public static partial void SeekTorrentStream(IntPtr streamHandle, long position);
+
+    /// <summary>
+    /// Gets the number of bytes that can be read from the stream's current position without waiting.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "get_torrent_stream_available")]
+    public static partial long GetTorrentStreamAvailable(IntPtr streamHandle);
+
+    /// <summary>
+    /// Gets the playback metrics for a stream.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "get_torrent_stream_stats")]
+    public static partial void GetTorrentStreamStats(IntPtr streamHandle, out NativeStructs.TorrentStreamStats stats);
+
+    /// <summary>
+    /// Closes a stream, clearing any outstanding piece deadlines.
+    /// </summary>
+    [LibraryImport(LibraryName, EntryPoint = "close_torrent_stream")]
+    public static partial void CloseTorrentStream(IntPtr streamHandle);
+
+    /// <summary>
+    /// Gets the number of bytes downloaded for every file within a torrent.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="progress">Buffer to copy the progress of each file into, indexed by file</param>
+    /// <param name="count">The length of <see cref="progress"/></param>
+    /// <param name="pieceGranularity">Only count complete pieces. Less precise, but much cheaper to calculate</param>
+    /// <returns>The number of files in the torrent. If larger than <see cref="count"/>, only the first <see cref="count"/> files were copied</returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_file_progress")]
+    public static unsafe partial int GetFileProgress(IntPtr torrentSessionHandle, long* progress, int count, [MarshalAs(UnmanagedType.I1)] bool pieceGranularity);
+
     /// <summary>
     /// Starts or resumes a torrent download
     /// </summary>
@@ -184,6 +505,34 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "reannounce_torrent")]
     public static partial void ReannounceTorrent(IntPtr torrentSessionHandle, int seconds, [MarshalAs(UnmanagedType.I1)] bool force);
 
+    /// <summary>
+    /// Connects a torrent directly to a peer.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle</param>
+    /// <param name="address">The peer's IP address</param>
+    /// <param name="port">The peer's listening port</param>
+    /// <returns>Whether the address was valid</returns>
+    [LibraryImport(LibraryName, EntryPoint = "connect_peer", StringMarshalling = StringMarshalling.Utf8)]
+    [return: MarshalAs(UnmanagedType.I1)]
+    public static partial bool ConnectPeer(IntPtr torrentSessionHandle, [MarshalAs(UnmanagedType.LPUTF8Str)] string address, int port);
+
+    /// <summary>
+    /// Requests resume data for a torrent, delivered as a <see cref="NativeEvents.ResumeDataAlert"/>.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle to save resume data for</param>
+    /// <param name="flags">Options controlling what is saved</param>
+    [LibraryImport(LibraryName, EntryPoint = "save_resume_data")]
+    public static partial void SaveResumeData(IntPtr torrentSessionHandle, ResumeDataFlags flags);
+
+    /// <summary>
+    /// Requests resume data for every torrent in a session.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to save resume data for</param>
+    /// <param name="flags">Options controlling what is saved. <see cref="ResumeDataFlags.OnlyIfModified"/> skips torrents that haven't changed</param>
+    /// <returns>The number of <see cref="NativeEvents.ResumeDataAlert"/>s that will be raised</returns>
+    [LibraryImport(LibraryName, EntryPoint = "save_all_resume_data")]
+    public static partial int SaveAllResumeData(IntPtr sessionHandle, ResumeDataFlags flags);
+
     /// <summary>
     /// Gets the status of a torrent.
     /// </summary>
@@ -192,6 +541,24 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "get_torrent_status")]
     public static partial void GetTorrentStatus(IntPtr torrentSessionHandle, out TorrentStatus status);
 
+    /// <summary>
+    /// Gets the extended status of a torrent.
+    /// </summary>
+    /// <param name="torrentSessionHandle">The torrent session handle to retrieve status information for</param>
+    /// <param name="status">The status to populate. <see cref="NativeStructs.TorrentStatusEx.struct_size"/> and <see cref="NativeStructs.TorrentStatusEx.fields"/> must be set beforehand</param>
+    [LibraryImport(LibraryName, EntryPoint = "get_torrent_status_ex")]
+    public static partial void GetTorrentStatusEx(IntPtr torrentSessionHandle, ref NativeStructs.TorrentStatusEx status);
+
+    /// <summary>
+    /// Gets the status of every torrent attached to a session in a single call.
+    /// </summary>
+    /// <param name="sessionHandle">The session handle to retrieve status information for</param>
+    /// <param name="statuses">Buffer to populate with status entries</param>
+    /// <param name="max">The number of entries <see cref="statuses"/> can hold</param>
+    /// <returns>The total number of torrents in the session, which may exceed <see cref="max"/></returns>
+    [LibraryImport(LibraryName, EntryPoint = "get_all_torrent_status")]
+    public static unsafe partial int GetAllTorrentStatus(IntPtr sessionHandle, NativeStructs.TorrentStatusEntry* statuses, int max);
+
     #region Settings Pack
 
     /// <summary>
@@ -255,5 +622,47 @@ internal static partial class NativeMethods
     [LibraryImport(LibraryName, EntryPoint = "settings_pack_set_str", StringMarshalling = StringMarshalling.Utf8)]
     public static partial bool SettingsPackSetString(IntPtr settingsPack, string key, string value);
 
+    /// <summary>
+    /// Gets a <see cref="string"/> from the settings pack
+    /// </summary>
+    /// <remarks>
+    /// The returned string is owned by the pack, and is only valid until the pack is changed or freed.
+    /// </remarks>
+    /// <param name="settingsPack">The pack handle</param>
+    /// <param name="key">The configuration key to read (case-insensitive)</param>
+    /// <returns>A pointer to the UTF-8 value, or <see cref="IntPtr.Zero"/> if the key isn't a string setting or hasn't been set</returns>
+    [LibraryImport(LibraryName, EntryPoint = "settings_pack_get_str", StringMarshalling = StringMarshalling.Utf8)]
+    public static partial IntPtr SettingsPackGetString(IntPtr settingsPack, string key);
+
+    /// <summary>
+    /// Gets a <see cref="bool"/> value from the settings pack
+    /// </summary>
+    /// <param name="settingsPack">The pack handle</param>
+    /// <param name="key">The configuration key to read (case-insensitive)</param>
+    /// <param name="value">The value, if found</param>
+    /// <returns>Whether the key is a boolean setting that has been set in the pack</returns>
+    [return: MarshalAs(UnmanagedType.I1)]
+    [LibraryImport(LibraryName, EntryPoint = "settings_pack_get_bool", StringMarshalling = StringMarshalling.Utf8)]
+    public static partial bool SettingsPackGetBool(IntPtr settingsPack, string key, [MarshalAs(UnmanagedType.I1)] out bool value);
+
+    /// <summary>
+    /// Gets an <see cref="int"/> value from the settings pack
+    /// </summary>
+    /// <param name="settingsPack">The pack handle</param>
+    /// <param name="key">The configuration key to read (case-insensitive)</param>
+    /// <param name="value">The value, if found</param>
+    /// <returns>Whether the key is an integer setting that has been set in the pack</returns>
+    [return: MarshalAs(UnmanagedType.I1)]
+    [LibraryImport(LibraryName, EntryPoint = "settings_pack_get_int", StringMarshalling = StringMarshalling.Utf8)]
+    public static partial bool SettingsPackGetInt(IntPtr settingsPack, string key, out int value);
+
+    /// <summary>
+    /// Gets the configuration key for a libtorrent setting id
+    /// </summary>
+    /// <param name="setting">The setting id, as used by libtorrent's settings_pack</param>
+    /// <returns>A pointer to a static UTF-8 string, or <see cref="IntPtr.Zero"/> if the id isn't a setting</returns>
+    [LibraryImport(LibraryName, EntryPoint = "settings_key_name")]
+    public static partial IntPtr GetSettingsKeyName(int setting);
+
     #endregion
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 using System;
 using System.Runtime.InteropServices;
+using csdl.Enums;
 
 namespace csdl.Native;
 
@@ -21,17 +22,12 @@ internal static class NativeStructs
 
         public readonly long modified_time;
 
-        [MarshalAs(UnmanagedType.LPUTF8Str)]
-        public readonly string file_name;
-
-        [MarshalAs(UnmanagedType.LPUTF8Str)]
-        public readonly string file_path;
+        // kept blittable so lists can be read in place - both point into the list's own allocation
+        public readonly IntPtr file_name;
+        public readonly IntPtr file_path;
 
-        [MarshalAs(UnmanagedType.I1)]
-        public readonly bool file_path_is_absolute;
-
-        [MarshalAs(UnmanagedType.I1)]
-        public readonly bool pad_file;
+        public readonly byte file_path_is_absolute;
+        public readonly byte pad_file;
     }
 
     /// <summary>
@@ -44,6 +40,16 @@ internal static class NativeStructs
         public readonly IntPtr items;
     }
 
+    /// <summary>
+    /// Represents a serialized session state.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public readonly struct SessionState
+    {
+        public readonly int length;
+        public readonly IntPtr data;
+    }
+
     /// <summary>
     /// Represents a single file contained within a torrent.
     /// </summary>
@@ -70,4 +76,142 @@ internal static class NativeStructs
         [MarshalAs(UnmanagedType.ByValArray, SizeConst = 32)]
         public readonly byte[] info_hash_sha256;
     }
+
+    /// <summary>
+    /// Counters for the thread dispatching session events.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public readonly struct AlertPumpStats
+    {
+        public readonly long threads_started;
+        public readonly long notifications;
+        public readonly long wakeups;
+
+        public readonly long wakeup_latency_total_ns;
+        public readonly long wakeup_latency_max_ns;
+
+        public readonly long timer_ticks;
+    }
+
+    /// <summary>
+    /// A torrent status, keyed by the v1 info hash of the torrent it belongs to.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public unsafe struct TorrentStatusEntry
+    {
+        public fixed byte info_hash[20];
+
+        public TorrentStatus status;
+    }
+
+    /// <summary>
+    /// Extended torrent status, versioned by <see cref="struct_size"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct TorrentStatusEx
+    {
+        public int struct_size;
+        public TorrentStatusFields fields;
+
+        public TorrentStatus status;
+
+        public int num_pieces;
+        public int queue_position;
+
+        public long total_wanted;
+        public long total_wanted_done;
+        public long total_done;
+
+        public float distributed_copies;
+
+        public int list_peers;
+        public int list_seeds;
+        public int connect_candidates;
+        public int num_connections;
+
+        public int num_complete;
+        public int num_incomplete;
+
+        public long next_announce;
+        public long active_time;
+        public long finished_time;
+        public long seeding_time;
+
+        public long last_seen_complete;
+
+        public IntPtr pieces;
+        public int pieces_size;
+        public int pieces_count;
+    }
+
+    /// <summary>
+    /// A single torrent to attach using <see cref="NativeMethods.AttachTorrentsAsync"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct AttachRequest
+    {
+        public IntPtr torrent;
+
+        // UTF-8 encoded
+        public IntPtr save_path;
+
+        public long request_id;
+
+        public IntPtr resume_data;
+        public int resume_data_length;
+    }
+
+    /// <summary>
+    /// A single file priority change, passed to <see cref="NativeMethods.SetFilePrioritiesSparse"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct FilePriorityUpdate
+    {
+        public int file_index;
+        public FileDownloadPriority priority;
+    }
+
+    /// <summary>
+    /// Playback metrics for a stream opened with <see cref="NativeMethods.OpenTorrentStream"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct TorrentStreamStats
+    {
+        public long position;
+        public int window_first_piece;
+        public int window_last_piece;
+
+        public long time_to_first_byte_ms;
+
+        public int stall_count;
+        public long stall_time_ms;
+
+        public int seek_count;
+    }
+
+    /// <summary>
+    /// Describes a single entry in the counters of a <see cref="NativeEvents.SessionStatsAlert"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public struct SessionStatsMetric
+    {
+        public IntPtr name;
+        public int value_index;
+        public StatsMetricType type;
+    }
+
+    /// <summary>
+    /// A histogram collected by the native instrumentation layer.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential, Pack = 8)]
+    public unsafe struct NativeHistogram
+    {
+        public const int BucketCount = 160;
+
+        public long count;
+        public long total;
+        public long max;
+
+        public fixed long buckets[BucketCount];
+    }
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using csdl.Enums;
+using csdl.Native;
+
+namespace csdl;
+
+/// <summary>
+/// A log-linear histogram of values recorded for a <see cref="NativeMetric"/>.
+/// </summary>
+/// <param name="Count">The number of values recorded</param>
+/// <param name="Total">The sum of all values recorded</param>
+/// <param name="Max">The largest value recorded</param>
+/// <param name="Buckets">The number of values recorded in each bucket (see <see cref="GetBucketLowerBound"/>)</param>
+public record NativeMetricHistogram(long Count, long Total, long Max, long[] Buckets)
+{
+    /// <summary>
+    /// Gets the smallest value that falls into a bucket.
+    /// </summary>
+    public static long GetBucketLowerBound(int bucket)
+    {
+        // values below 4 have a bucket each, then every power of two is split into four (buckets 4-7 are unused)
+        return bucket < 4 ? bucket : (4L + bucket % 4) << (bucket / 4 - 2);
+    }
+
+    /// <summary>
+    /// Estimates a percentile from the buckets, returning the lower bound of the bucket it falls into.
+    /// </summary>
+    /// <param name="percentile">The percentile to estimate, between 0 and 100</param>
+    public long EstimatePercentile(double percentile)
+    {
+        if (percentile is < 0 or > 100)
+        {
+            throw new ArgumentOutOfRangeException(nameof(percentile), "Percentile must be between 0 and 100.");
+        }
+
+        var target = (long)Math.Ceiling(Count * percentile / 100);
+        var seen = 0L;
+
+        for (var i = 0; i < Buckets.Length; i++)
+        {
+            seen += Buckets[i];
+
+            if (seen >= target && seen > 0)
+            {
+                return GetBucketLowerBound(i);
+            }
+        }
+
+        return 0;
+    }
+}
+
+/// <summary>
+/// Opt-in latency tracking for calls into the native library, and the alert dispatch thread.
+/// </summary>
+/// <remarks>
+/// Tracking applies to every session in the process. While disabled, the cost to each call is negligible.
+/// </remarks>
+public static class NativeMetrics
+{
+    private static bool _enabled;
+
+    /// <summary>
+    /// Gets or sets whether native calls are being tracked. Disabled by default.
+    /// </summary>
+    public static bool Enabled
+    {
+        get => _enabled;
+        set
+        {
+            _enabled = value;
+            NativeMethods.SetNativeMetricsEnabled(value);
+        }
+    }
+
+    /// <summary>
+    /// Gets the histogram for a metric. Latencies are in nanoseconds.
+    /// </summary>
+    public static unsafe NativeMetricHistogram Get(NativeMetric metric)
+    {
+        if (!NativeMethods.GetNativeMetrics(metric, out var histogram))
+        {
+            throw new ArgumentOutOfRangeException(nameof(metric), "Unknown metric.");
+        }
+
+        var buckets = new ReadOnlySpan<long>(histogram.buckets, NativeStructs.NativeHistogram.BucketCount).ToArray();
+        return new NativeMetricHistogram(histogram.count, histogram.total, histogram.max, buckets);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using csdl.Native;
+
+namespace csdl;
+
+/// <summary>
+/// The contents of a piece, read directly from the native piece buffer without copying.
+/// </summary>
+/// <remarks>
+/// The underlying memory is shared with the native library, and is only released once this is disposed.
+/// </remarks>
+public class PieceBuffer : IDisposable
+{
+    private readonly IntPtr _handle;
+    private readonly IntPtr _data;
+
+    private bool _disposed;
+
+    internal PieceBuffer(IntPtr handle, IntPtr data, int length)
+    {
+        _handle = handle;
+        _data = data;
+
+        Length = length;
+    }
+
+    ~PieceBuffer()
+    {
+        Dispose();
+    }
+
+    /// <summary>
+    /// The size of the piece, in bytes.
+    /// </summary>
+    public int Length { get; }
+
+    /// <summary>
+    /// Gets the piece contents. The span must not be used after the buffer has been disposed.
+    /// </summary>
+    public unsafe ReadOnlySpan<byte> Span
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            return new ReadOnlySpan<byte>(_data.ToPointer(), Length);
+        }
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        NativeMethods.ReleasePieceBuffer(_handle);
+
+        GC.SuppressFinalize(this);
+    }
+}
\ No newline at end of file
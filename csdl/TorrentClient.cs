@@ -5,7 +5,10 @@ using System;
 using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.IO;
+using System.Linq;
 using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
 using csdl.Alerts;
 using csdl.Enums;
 using csdl.Native;
@@ -17,16 +20,21 @@ namespace csdl;
 /// </summary>
 public class TorrentClient : IDisposable
 {
-    internal const AlertCategories RequiredAlertCategories = AlertCategories.Status;
+    internal const AlertCategories RequiredAlertCategories = AlertCategories.Status | AlertCategories.Storage;
 
     private readonly ConcurrentDictionary<string, TorrentManager> _attachedManagers = new(StringComparer.OrdinalIgnoreCase);
+    private readonly ConcurrentDictionary<long, PendingAttach> _pendingAttaches = new();
+    private readonly ConcurrentDictionary<string, PendingMagnet> _pendingMagnets = new(StringComparer.OrdinalIgnoreCase);
 
     // need to keep a reference to the delegate to prevent GC invalidating it
-    private readonly NativeMethods.SessionEventCallback _eventCallback;
+    private readonly NativeMethods.SessionEventBatchCallback _eventCallback;
     private readonly IntPtr _handle;
 
     private bool _disposed;
     private bool _includeUnmappedEvents;
+    private bool _includeAlertMessages = true;
+    private string _metadataCachePath;
+    private long _lastAttachRequestId;
 
     /// <summary>
     /// Creates a new instance of <see cref="TorrentClient"/> with default settings.
@@ -42,10 +50,27 @@ public class TorrentClient : IDisposable
     {
     }
 
+    /// <summary>
+    /// Creates a new instance of <see cref="TorrentClient"/> with the provided configuration, restoring state saved by <see cref="SaveState"/>.
+    /// </summary>
+    public TorrentClient(TorrentClientConfig config, byte[] sessionState) : this(config.Build(), sessionState)
+    {
+    }
+
     /// <summary>
     /// Creates a new instance of <see cref="TorrentClient"/> with the provided settings pack (advanced usage).
     /// </summary>
-    public unsafe TorrentClient(SettingsPack pack)
+    public TorrentClient(SettingsPack pack) : this(pack, null)
+    {
+    }
+
+    /// <summary>
+    /// Creates a new instance of <see cref="TorrentClient"/> with the provided settings pack, restoring state saved by <see cref="SaveState"/> (advanced usage).
+    /// </summary>
+    /// <remarks>
+    /// The settings pack is always used in place of any settings contained in <see cref="sessionState"/>.
+    /// </remarks>
+    public unsafe TorrentClient(SettingsPack pack, byte[] sessionState)
     {
         ValidateSettingsPack(pack);
 
@@ -53,15 +78,17 @@ public class TorrentClient : IDisposable
 
         try
         {
-            _handle = NativeMethods.CreateSession(packHandle.ToPointer());
+            _handle = sessionState == null
+                ? NativeMethods.CreateSession(packHandle.ToPointer())
+                : NativeMethods.CreateSessionFromState(sessionState, sessionState.Length, SessionStateFlags.Dht | SessionStateFlags.Extensions | SessionStateFlags.IPFilter, packHandle.ToPointer());
 
             if (_handle == IntPtr.Zero)
             {
                 throw new InvalidOperationException("Failed to create session.");
             }
 
-            _eventCallback = ProxyRaisedEvent;
-            NativeMethods.SetEventCallback(_handle, _eventCallback, true);
+            _eventCallback = ProxyRaisedEvents;
+            NativeMethods.SetEventBatchCallback(_handle, _eventCallback, NativeEvents.EventFlags.IncludeUnmapped | NativeEvents.EventFlags.FormatMessages);
         }
         finally
         {
@@ -93,12 +120,26 @@ public class TorrentClient : IDisposable
             ObjectDisposedException.ThrowIf(_disposed, this);
             _includeUnmappedEvents = value;
 
-            // reset event callback if set
-            if (_eventCallback != null)
-            {
-                NativeMethods.ClearEventCallback(_handle);
-                NativeMethods.SetEventCallback(_handle, _eventCallback, value);
-            }
+            ResetEventCallback();
+        }
+    }
+
+    /// <summary>
+    /// Whether to populate <see cref="SessionAlert.Message"/>.
+    /// Formatting messages has a noticeable cost on busy sessions, so disabling this is recommended if they aren't used.
+    /// </summary>
+    /// <remarks>
+    /// Changing this value after subscribing will cause the event callback to be reset.
+    /// </remarks>
+    public bool IncludeAlertMessages
+    {
+        get => _includeAlertMessages;
+        set
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            _includeAlertMessages = value;
+
+            ResetEventCallback();
         }
     }
 
@@ -108,6 +149,34 @@ public class TorrentClient : IDisposable
     /// </summary>
     public string DefaultDownloadPath { get; set; } = Path.Combine(Environment.CurrentDirectory, "downloads");
 
+    /// <summary>
+    /// Gets the port the client is accepting peer connections on, or 0 if it isn't listening.
+    /// </summary>
+    public int ListenPort
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            return NativeMethods.GetListenPort(_handle);
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets the directory metadata downloaded for magnet links is cached in.
+    /// When set, attaching a magnet link that has been seen before skips downloading the metadata from peers.
+    /// </summary>
+    public string MetadataCachePath
+    {
+        get => _metadataCachePath;
+        set
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            _metadataCachePath = string.IsNullOrEmpty(value) ? null : Path.GetFullPath(value);
+
+            NativeMethods.SetMetadataCacheDir(_handle, _metadataCachePath);
+        }
+    }
+
     /// <summary>
     /// Event invoked when a session alert is raised.
     /// The underlying event collection system is unmanaged, and is started/shutdown on the first/last subscription to this event.
@@ -133,14 +202,80 @@ public class TorrentClient : IDisposable
         }
     }
 
+    /// <summary>
+    /// Saves the state of the session, allowing it to be restored by passing it to the <see cref="TorrentClient"/> constructor.
+    /// </summary>
+    /// <param name="flags">The parts of the session state to save</param>
+    public byte[] SaveState(SessionStateFlags flags = SessionStateFlags.Dht | SessionStateFlags.Extensions | SessionStateFlags.IPFilter)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        NativeMethods.SaveSessionState(_handle, flags, out var state);
+
+        try
+        {
+            var buffer = new byte[state.length];
+            Marshal.Copy(state.data, buffer, 0, state.length);
+
+            return buffer;
+        }
+        finally
+        {
+            NativeMethods.FreeSessionState(ref state);
+        }
+    }
+
+    /// <summary>
+    /// Folds peer events into a <see cref="PeerSummaryAlert"/> per torrent, raised once every <paramref name="window"/>.
+    /// </summary>
+    /// <param name="window">The length of each summary window. Use <see cref="TimeSpan.Zero"/> to disable summaries</param>
+    /// <param name="includePeerAlerts">Whether individual <see cref="PeerAlert"/>s should still be raised</param>
+    public void SetPeerAlertSummaries(TimeSpan window, bool includePeerAlerts = false)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        if (window < TimeSpan.Zero)
+        {
+            throw new ArgumentOutOfRangeException(nameof(window), "Window must be a positive value.");
+        }
+
+        NativeMethods.SetPeerAlertAggregation(_handle, (int)window.TotalMilliseconds, includePeerAlerts || window == TimeSpan.Zero);
+    }
+
+    /// <summary>
+    /// Requests a <see cref="TorrentStatusUpdateAlert"/> containing every torrent whose status changed, raised once every <paramref name="interval"/>.
+    /// </summary>
+    /// <remarks>
+    /// This is a cheaper alternative to polling <see cref="GetAllTorrentStatus"/> when most torrents are idle.
+    /// </remarks>
+    /// <param name="interval">The time between updates. Use <see cref="TimeSpan.Zero"/> to stop updates</param>
+    public void SetStatusUpdateInterval(TimeSpan interval)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        if (interval < TimeSpan.Zero)
+        {
+            throw new ArgumentOutOfRangeException(nameof(interval), "Interval must be a positive value.");
+        }
+
+        NativeMethods.SetStatusUpdateInterval(_handle, (int)interval.TotalMilliseconds);
+    }
+
+    /// <summary>
+    /// Requests a snapshot of the session's performance counters, raised as a <see cref="SessionStatsAlert"/>.
+    /// </summary>
+    public void RequestSessionStats()
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        NativeMethods.PostSessionStats(_handle);
+    }
+
     /// <summary>
     /// Attaches a torrent to the session, allowing it to be downloaded/uploaded.
     /// </summary>
     /// <param name="torrent">The <see cref="TorrentInfo"/> to attach</param>
     /// <param name="savePath">The path to save/read data from</param>
+    /// <param name="resumeData">Optional resume data (see <see cref="ResumeDataAlert"/>), used to skip rechecking existing files</param>
     /// <returns>A <see cref="TorrentManager"/> allowing the torrent to be controlled.</returns>
     /// <exception cref="InvalidOperationException">The torrent was unable to be attached to the underlying session</exception>
-    public TorrentManager AttachTorrent(TorrentInfo torrent, string savePath = null)
+    public TorrentManager AttachTorrent(TorrentInfo torrent, string savePath = null, byte[] resumeData = null)
     {
         ObjectDisposedException.ThrowIf(_disposed, this);
 
@@ -149,31 +284,161 @@ public class TorrentClient : IDisposable
             throw new InvalidOperationException("Torrent is already attached to this session.");
         }
 
-        savePath ??= DefaultDownloadPath;
+        savePath = PrepareSavePath(savePath);
 
-        // relative paths will be combined with the default download path
-        if (!Path.IsPathRooted(savePath))
+        var handle = resumeData == null
+            ? NativeMethods.AttachTorrent(_handle, torrent.InfoHandle, Path.GetFullPath(savePath))
+            : NativeMethods.AttachTorrentWithResume(_handle, torrent.InfoHandle, Path.GetFullPath(savePath), resumeData, resumeData.Length);
+
+        if (handle == IntPtr.Zero)
         {
-            savePath = Path.Combine(DefaultDownloadPath, savePath);
+            throw new InvalidOperationException("Failed to attach torrent to session.");
         }
 
-        // ensure the save path exists
-        if (!Directory.Exists(savePath))
+        var manager = new TorrentManager(handle, savePath, torrent);
+        _attachedManagers.TryAdd(manager.Info.Metadata.InfoHash, manager);
+
+        return manager;
+    }
+
+    /// <summary>
+    /// Attaches a batch of torrents to the session without waiting for each one to be added in turn.
+    /// This is significantly faster than calling <see cref="AttachTorrent"/> repeatedly when attaching a large number of torrents.
+    /// </summary>
+    /// <remarks>
+    /// Each torrent is reported back through the session's alert queue, which is enlarged to fit the batch if <c>alert_queue_size</c> is too small.
+    /// Results that are still dropped from the queue are recovered by looking the torrent up, so every returned task completes.
+    /// </remarks>
+    /// <param name="torrents">The torrents to attach</param>
+    /// <param name="savePath">The path to save/read data from</param>
+    /// <param name="cancellationToken">Cancels waiting for any torrents not yet attached, detaching them once they've been added</param>
+    /// <returns>The <see cref="TorrentManager"/>s for each torrent, in the same order as <see cref="torrents"/>.</returns>
+    /// <exception cref="InvalidOperationException">A torrent was already attached, or was unable to be attached to the underlying session</exception>
+    public unsafe Task<TorrentManager[]> AttachTorrentsAsync(IReadOnlyList<TorrentInfo> torrents, string savePath = null, CancellationToken cancellationToken = default)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        if (torrents.Any(x => _attachedManagers.ContainsKey(x.Metadata.InfoHash)))
         {
-            Directory.CreateDirectory(savePath);
+            throw new InvalidOperationException("One or more torrents are already attached to this session.");
         }
 
-        var handle = NativeMethods.AttachTorrent(_handle, torrent.InfoHandle, Path.GetFullPath(savePath));
+        savePath = PrepareSavePath(savePath);
+
+        var tasks = new Task<TorrentManager>[torrents.Count];
+        var pendingAttaches = new PendingAttach[torrents.Count];
+        var requests = new NativeStructs.AttachRequest[torrents.Count];
+        var savePathPtr = Marshal.StringToCoTaskMemUTF8(Path.GetFullPath(savePath));
+
+        try
+        {
+            for (var i = 0; i < torrents.Count; i++)
+            {
+                var requestId = Interlocked.Increment(ref _lastAttachRequestId);
+                var pending = new PendingAttach(torrents[i], savePath);
+
+                _pendingAttaches[requestId] = pending;
+                pendingAttaches[i] = pending;
+                tasks[i] = pending.Completion.Task;
+
+                requests[i] = new NativeStructs.AttachRequest
+                {
+                    torrent = torrents[i].InfoHandle,
+                    save_path = savePathPtr,
+                    request_id = requestId
+                };
+            }
+
+            fixed (NativeStructs.AttachRequest* requestsPtr = requests)
+            {
+                NativeMethods.AttachTorrentsAsync(_handle, requestsPtr, requests.Length);
+            }
+        }
+        finally
+        {
+            Marshal.FreeCoTaskMem(savePathPtr);
+        }
+
+        if (cancellationToken.CanBeCanceled)
+        {
+            // requests stay pending until their torrent is added, so CompleteAttach can detach it again
+            cancellationToken.Register(() =>
+            {
+                foreach (var pending in pendingAttaches)
+                {
+                    pending.Completion.TrySetCanceled(cancellationToken);
+                }
+            });
+        }
+
+        return Task.WhenAll(tasks);
+    }
+
+    /// <summary>
+    /// Attaches a torrent from a magnet link, completing once its metadata is available.
+    /// If <see cref="MetadataCachePath"/> is set and contains the metadata, the returned task completes immediately.
+    /// </summary>
+    /// <remarks>
+    /// The torrent runs until the metadata has been downloaded and checked, then stops until <see cref="TorrentManager.Start"/> is called.
+    /// </remarks>
+    /// <param name="magnetUri">The magnet link to attach</param>
+    /// <param name="savePath">The path to save/read data from</param>
+    /// <param name="cancellationToken">Cancels waiting for the metadata, detaching the torrent</param>
+    /// <returns>A <see cref="TorrentManager"/> allowing the torrent to be controlled.</returns>
+    /// <exception cref="InvalidOperationException">The link was invalid, or the torrent is already attached to this session</exception>
+    public unsafe Task<TorrentManager> AttachMagnetAsync(string magnetUri, string savePath = null, CancellationToken cancellationToken = default)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        ArgumentException.ThrowIfNullOrEmpty(magnetUri);
+
+        savePath = PrepareSavePath(savePath);
+
+        var handle = NativeMethods.AttachMagnet(_handle, magnetUri, Path.GetFullPath(savePath));
 
         if (handle == IntPtr.Zero)
         {
-            throw new InvalidOperationException("Failed to attach torrent to session.");
+            throw new InvalidOperationException("Failed to attach magnet link to session. Ensure the link is valid and the torrent isn't already attached.");
         }
 
-        var manager = new TorrentManager(handle, savePath, torrent);
-        _attachedManagers.TryAdd(manager.Info.Metadata.InfoHash, manager);
+        Span<byte> infoHashBytes = stackalloc byte[20];
 
-        return manager;
+        fixed (byte* infoHashPtr = infoHashBytes)
+        {
+            NativeMethods.GetTorrentInfoHash(handle, infoHashPtr);
+        }
+
+        var infoHash = Convert.ToHexString(infoHashBytes);
+        var pending = new PendingMagnet(handle, savePath);
+
+        _pendingMagnets[infoHash] = pending;
+
+        if (cancellationToken.CanBeCanceled)
+        {
+            cancellationToken.Register(() =>
+            {
+                if (_pendingMagnets.TryRemove(KeyValuePair.Create(infoHash, pending)))
+                {
+                    NativeMethods.DetachTorrent(_handle, pending.Handle);
+                    pending.Completion.TrySetCanceled(cancellationToken);
+                }
+            });
+        }
+
+        // the metadata was either cached or arrived before the request was registered
+        CompleteMagnet(infoHash);
+
+        return pending.Completion.Task;
+    }
+
+    /// <summary>
+    /// Requests resume data for the attached torrents, each raised as a <see cref="ResumeDataAlert"/> once ready.
+    /// </summary>
+    /// <param name="flags">Options controlling what is saved. By default, only torrents that have changed since their last save are included</param>
+    /// <returns>The number of <see cref="ResumeDataAlert"/>s that will be raised</returns>
+    public int SaveAllResumeData(ResumeDataFlags flags = ResumeDataFlags.OnlyIfModified)
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        return NativeMethods.SaveAllResumeData(_handle, flags);
     }
 
     /// <summary>
@@ -194,6 +459,41 @@ public class TorrentClient : IDisposable
         NativeMethods.DetachTorrent(_handle, manager.TorrentSessionHandle);
     }
 
+    /// <summary>
+    /// Gets the current status of every attached torrent.
+    /// </summary>
+    /// <remarks>
+    /// Prefer this over calling <see cref="TorrentManager.GetCurrentStatus"/> on each torrent, as the statuses are all collected at once.
+    /// </remarks>
+    public unsafe IReadOnlyDictionary<TorrentManager, TorrentStatus> GetAllTorrentStatus()
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+
+        var entries = new NativeStructs.TorrentStatusEntry[Math.Max(_attachedManagers.Count, 1)];
+        int count;
+
+        // torrents can be added between calls, so retry until the buffer is big enough
+        while (true)
+        {
+            fixed (NativeStructs.TorrentStatusEntry* entriesPtr = entries)
+            {
+                count = NativeMethods.GetAllTorrentStatus(_handle, entriesPtr, entries.Length);
+            }
+
+            if (count <= entries.Length)
+            {
+                break;
+            }
+
+            entries = new NativeStructs.TorrentStatusEntry[count];
+        }
+
+        fixed (NativeStructs.TorrentStatusEntry* entriesPtr = entries)
+        {
+            return ResolveStatusEntries(entriesPtr, count);
+        }
+    }
+
     public void Dispose()
     {
         if (_disposed)
@@ -216,11 +516,136 @@ public class TorrentClient : IDisposable
         _disposed = true;
 
         NativeMethods.ClearEventCallback(_handle);
+
+        foreach (var infoHash in _pendingMagnets.Keys)
+        {
+            if (_pendingMagnets.TryRemove(infoHash, out var pending))
+            {
+                NativeMethods.DetachTorrent(_handle, pending.Handle);
+                pending.Completion.TrySetCanceled();
+            }
+        }
+
+        // no more alerts will arrive to complete these
+        foreach (var requestId in _pendingAttaches.Keys)
+        {
+            if (_pendingAttaches.TryRemove(requestId, out var pending))
+            {
+                pending.Completion.TrySetCanceled();
+            }
+        }
+
         NativeMethods.FreeSession(_handle);
 
         GC.SuppressFinalize(this);
     }
 
+    /// <summary>
+    /// Re-registers the event callback with flags matching the current configuration.
+    /// </summary>
+    private void ResetEventCallback()
+    {
+        if (_eventCallback == null)
+        {
+            return;
+        }
+
+        var flags = NativeEvents.EventFlags.None;
+
+        if (_includeUnmappedEvents)
+        {
+            flags |= NativeEvents.EventFlags.IncludeUnmapped;
+        }
+
+        if (_includeAlertMessages)
+        {
+            flags |= NativeEvents.EventFlags.FormatMessages;
+        }
+
+        NativeMethods.ClearEventCallback(_handle);
+        NativeMethods.SetEventBatchCallback(_handle, _eventCallback, flags);
+    }
+
+    /// <summary>
+    /// Resolves a save path against <see cref="DefaultDownloadPath"/>, ensuring the directory exists.
+    /// </summary>
+    private string PrepareSavePath(string savePath)
+    {
+        savePath ??= DefaultDownloadPath;
+
+        // relative paths will be combined with the default download path
+        if (!Path.IsPathRooted(savePath))
+        {
+            savePath = Path.Combine(DefaultDownloadPath, savePath);
+        }
+
+        // ensure the save path exists
+        if (!Directory.Exists(savePath))
+        {
+            Directory.CreateDirectory(savePath);
+        }
+
+        return savePath;
+    }
+
+    /// <summary>
+    /// Completes a pending <see cref="AttachTorrentsAsync"/> request once the torrent has been added (or failed to be).
+    /// </summary>
+    private void CompleteAttach(NativeEvents.TorrentAddedAlert alert)
+    {
+        if (!_pendingAttaches.TryRemove(alert.request_id, out var pending))
+        {
+            return;
+        }
+
+        var handle = alert.handle == IntPtr.Zero ? IntPtr.Zero : NativeMethods.CopyTorrentHandle(alert.handle);
+
+        if (handle == IntPtr.Zero)
+        {
+            pending.Completion.TrySetException(new InvalidOperationException($"Failed to attach torrent to session (error {alert.error_code})."));
+            return;
+        }
+
+        var manager = new TorrentManager(handle, pending.SavePath, pending.Torrent);
+        _attachedManagers.TryAdd(manager.Info.Metadata.InfoHash, manager);
+
+        // the request was cancelled while the torrent was being added - the removal alert cleans up the manager
+        if (!pending.Completion.TrySetResult(manager))
+        {
+            NativeMethods.DetachTorrent(_handle, manager.TorrentSessionHandle);
+        }
+    }
+
+    /// <summary>
+    /// Completes a pending <see cref="AttachMagnetAsync"/> request if the torrent's metadata is available.
+    /// </summary>
+    private void CompleteMagnet(string infoHash)
+    {
+        if (!_pendingMagnets.TryGetValue(infoHash, out var pending))
+        {
+            return;
+        }
+
+        var infoHandle = NativeMethods.GetTorrentHandleInfo(pending.Handle);
+
+        if (infoHandle == IntPtr.Zero)
+        {
+            return;
+        }
+
+        // the alert and AttachMagnetAsync can race to complete the same request
+        if (!_pendingMagnets.TryRemove(KeyValuePair.Create(infoHash, pending)))
+        {
+            NativeMethods.FreeTorrent(infoHandle);
+            return;
+        }
+
+        var manager = new TorrentManager(pending.Handle, pending.SavePath, new TorrentInfo(infoHandle));
+        _attachedManagers.TryAdd(manager.Info.Metadata.InfoHash, manager);
+
+        pending.Completion.TrySetResult(manager);
+    }
+
     /// <summary>
     /// Performs a validation check on the current settings pack, updating any values to values required by this library to function
     /// </summary>
@@ -230,6 +655,40 @@ public class TorrentClient : IDisposable
         settingsPack.Set("alert_mask", settingsPack.Get<int>("alert_mask").GetValueOrDefault(0) | (int)RequiredAlertCategories);
     }
 
+    /// <summary>
+    /// Maps an unmanaged array of status entries to the managers they belong to, skipping any torrents not attached through this client.
+    /// </summary>
+    private unsafe Dictionary<TorrentManager, TorrentStatus> ResolveStatusEntries(NativeStructs.TorrentStatusEntry* entries, int count)
+    {
+        var statuses = new Dictionary<TorrentManager, TorrentStatus>(count);
+
+        for (var i = 0; i < count; i++)
+        {
+            var infoHash = Convert.ToHexString(new ReadOnlySpan<byte>(entries[i].info_hash, 20));
+
+            if (_attachedManagers.TryGetValue(infoHash, out var manager))
+            {
+                statuses[manager] = entries[i].status;
+            }
+        }
+
+        return statuses;
+    }
+
+    /// <summary>
+    /// Processes a batch of unmanaged events, delivered as a contiguous array of fixed-size records.
+    /// </summary>
+    /// <param name="eventsPtr">A <see cref="IntPtr"/> to the first record</param>
+    /// <param name="count">The number of records in the batch</param>
+    /// <param name="recordSize">The stride between records</param>
+    private void ProxyRaisedEvents(IntPtr eventsPtr, int count, int recordSize)
+    {
+        for (var i = 0; i < count; i++)
+        {
+            ProxyRaisedEvent(eventsPtr + i * recordSize);
+        }
+    }
+
     /// <summary>
     /// Marshals raised unmanaged events to managed equivalents, and forwards them to the <see cref="AlertRaised"/> event.
     /// These events are raised and proxied by the unmanaged library, and are automatically destroyed once the callback returns.
@@ -297,6 +756,74 @@ public class TorrentClient : IDisposable
                 forwardAlert = new TorrentRemovedAlert(removedAlert, manager);
                 break;
             }
+
+            case AlertType.PeerSummary:
+            {
+                var summaryAlert = Marshal.PtrToStructure<NativeEvents.PeerSummaryAlert>(eventPtr);
+                if (!_attachedManagers.TryGetValue(Convert.ToHexString(summaryAlert.info_hash), out var summarySubject))
+                {
+                    return;
+                }
+
+                forwardAlert = new PeerSummaryAlert(summaryAlert, summarySubject);
+                break;
+            }
+
+            case AlertType.TorrentAdded:
+            {
+                CompleteAttach(Marshal.PtrToStructure<NativeEvents.TorrentAddedAlert>(eventPtr));
+                return;
+            }
+
+            case AlertType.MetadataReceived:
+            {
+                CompleteMagnet(Convert.ToHexString(Marshal.PtrToStructure<NativeEvents.MetadataReceivedAlert>(eventPtr).info_hash));
+                return;
+            }
+
+            case AlertType.PieceRead:
+            {
+                var pieceAlert = Marshal.PtrToStructure<NativeEvents.PieceReadAlert>(eventPtr);
+                if (!_attachedManagers.TryGetValue(Convert.ToHexString(pieceAlert.info_hash), out var pieceSubject))
+                {
+                    return;
+                }
+
+                forwardAlert = new PieceReadAlert(pieceAlert, pieceSubject);
+                break;
+            }
+
+            case AlertType.SessionStats:
+            {
+                forwardAlert = new SessionStatsAlert(Marshal.PtrToStructure<NativeEvents.SessionStatsAlert>(eventPtr));
+                break;
+            }
+
+            case AlertType.ResumeData:
+            {
+                var resumeAlert = Marshal.PtrToStructure<NativeEvents.ResumeDataAlert>(eventPtr);
+                if (!_attachedManagers.TryGetValue(Convert.ToHexString(resumeAlert.info_hash), out var resumeSubject))
+                {
+                    return;
+                }
+
+                forwardAlert = new ResumeDataAlert(resumeAlert, resumeSubject);
+                break;
+            }
+
+            case AlertType.TorrentStatusUpdates:
+            {
+                var updateAlert = Marshal.PtrToStructure<NativeEvents.TorrentStatusUpdateAlert>(eventPtr);
+                var statuses = ResolveStatusEntries((NativeStructs.TorrentStatusEntry*)updateAlert.statuses, updateAlert.count);
+
+                if (statuses.Count == 0)
+                {
+                    return;
+                }
+
+                forwardAlert = new TorrentStatusUpdateAlert(updateAlert, statuses);
+                break;
+            }
         }
 
         if (forwardAlert == null)
@@ -307,4 +834,14 @@ public class TorrentClient : IDisposable
         // the native library always invokes this from another thread
         AlertRaised?.Invoke(this, forwardAlert);
     }
-}
\ No newline at end of file
+
+    private record PendingAttach(TorrentInfo Torrent, string SavePath)
+    {
+        public TaskCompletionSource<TorrentManager> Completion { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    }
+
+    private record PendingMagnet(IntPtr Handle, string SavePath)
+    {
+        public TaskCompletionSource<TorrentManager> Completion { get; } = new(TaskCreationOptions.RunContinuationsAsynchronously);
+    }
+}
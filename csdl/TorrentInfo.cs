@@ -98,6 +98,14 @@ public class TorrentInfo
     {
     }
 
+    /// <summary>
+    /// Wraps an existing native torrent handle, taking ownership of it.
+    /// </summary>
+    internal TorrentInfo(IntPtr infoHandle)
+    {
+        InfoHandle = infoHandle;
+    }
+
     // as TorrentInfo is shared a lot, we're not providing a dispose method
     // and instead letting the garbage collector handle it
     ~TorrentInfo()
@@ -142,24 +150,53 @@ public class TorrentInfo
         }
     }
 
+    /// <summary>
+    /// Gets a range of files contained within the torrent, without listing the rest.
+    /// Useful for paging through torrents containing a very large number of files.
+    /// </summary>
+    /// <param name="startIndex">The index of the first file to return</param>
+    /// <param name="count">The maximum number of files to return</param>
+    public IReadOnlyList<TorrentFileInfo> GetFiles(int startIndex, int count)
+    {
+        if (startIndex < 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(startIndex), "Start index must be a positive value.");
+        }
+
+        if (count < 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(count), "Count must be a positive value.");
+        }
+
+        NativeMethods.GetTorrentFileListRange(InfoHandle, startIndex, count, out var list);
+        return ReadFileList(list);
+    }
+
     private IReadOnlyCollection<TorrentFileInfo> GetFiles()
     {
         NativeMethods.GetTorrentFileList(InfoHandle, out var list);
+        return ReadFileList(list);
+    }
 
+    /// <summary>
+    /// Copies a native file list into managed objects, releasing the native list once done.
+    /// </summary>
+    private static unsafe List<TorrentFileInfo> ReadFileList(NativeStructs.TorrentFileList list)
+    {
         try
         {
             var files = new List<TorrentFileInfo>(list.length);
-            var size = Marshal.SizeOf<NativeStructs.TorrentFile>();
+            var nativeFiles = (NativeStructs.TorrentFile*)list.items;
 
             for (var i = 0; i < list.length; i++)
             {
-                var nativeFile = Marshal.PtrToStructure<NativeStructs.TorrentFile>(list.items + (size * i));
+                var nativeFile = nativeFiles[i];
                 var fileInfo = new TorrentFileInfo(nativeFile.index,
                     nativeFile.offset,
-                    nativeFile.file_name,
-                    nativeFile.file_path,
+                    Marshal.PtrToStringUTF8(nativeFile.file_name),
+                    Marshal.PtrToStringUTF8(nativeFile.file_path),
                     nativeFile.file_size,
-                    nativeFile.pad_file);
+                    nativeFile.pad_file != 0);
 
                 files.Add(fileInfo);
             }
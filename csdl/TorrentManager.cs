@@ -2,8 +2,10 @@
 // Licensed under Apache-2.0 - see the license file for more information
 
 using System;
+using System.Collections;
 using System.Collections.Generic;
 using System.Linq;
+using System.Net;
 using csdl.Enums;
 using csdl.Native;
 
@@ -15,6 +17,7 @@ public class TorrentManager
     internal readonly IntPtr TorrentSessionHandle;
 
     private bool _detached;
+    private int _pieceBitfieldSize;
     private IReadOnlyList<TorrentManagerFile> _files;
 
     internal TorrentManager(IntPtr torrentSessionHandle, string savePath, TorrentInfo info)
@@ -50,6 +53,189 @@ public class TorrentManager
         return status;
     }
 
+    /// <summary>
+    /// Gets the current status of the torrent, including additional information useful for queueing decisions.
+    /// </summary>
+    /// <param name="fields">Optional fields to populate. These are more expensive to collect, so should only be requested if needed</param>
+    public unsafe ExtendedTorrentStatus GetExtendedStatus(TorrentStatusFields fields = TorrentStatusFields.None)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        var status = new NativeStructs.TorrentStatusEx
+        {
+            struct_size = sizeof(NativeStructs.TorrentStatusEx),
+            fields = fields
+        };
+
+        var pieces = fields.HasFlag(TorrentStatusFields.Pieces) ? new byte[_pieceBitfieldSize] : null;
+
+        while (true)
+        {
+            fixed (byte* piecesPtr = pieces)
+            {
+                status.pieces = (IntPtr)piecesPtr;
+                status.pieces_size = pieces?.Length ?? 0;
+
+                NativeMethods.GetTorrentStatusEx(TorrentSessionHandle, ref status);
+            }
+
+            // the bitfield is only copied if the buffer was big enough - resize and try again if not
+            if (pieces == null || status.pieces_size <= pieces.Length)
+            {
+                break;
+            }
+
+            _pieceBitfieldSize = status.pieces_size;
+            pieces = new byte[_pieceBitfieldSize];
+        }
+
+        BitArray pieceBits = null;
+
+        if (pieces != null)
+        {
+            pieceBits = new BitArray(status.pieces_count);
+
+            // native bitfields are most significant bit first
+            for (var i = 0; i < pieceBits.Length; i++)
+            {
+                pieceBits[i] = (pieces[i / 8] & (0x80 >> (i % 8))) != 0;
+            }
+        }
+
+        return new ExtendedTorrentStatus(status, pieceBits);
+    }
+
+    /// <summary>
+    /// Gets the download priority of every file in the torrent, indexed by <see cref="TorrentFileInfo.Index"/>.
+    /// </summary>
+    public unsafe FileDownloadPriority[] GetFilePriorities()
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        var priorities = new FileDownloadPriority[Info.Metadata.TotalFiles];
+
+        fixed (FileDownloadPriority* prioritiesPtr = priorities)
+        {
+            NativeMethods.GetFilePriorities(TorrentSessionHandle, prioritiesPtr, priorities.Length);
+        }
+
+        return priorities;
+    }
+
+    /// <summary>
+    /// Sets the download priority of every file in the torrent at once.
+    /// This is significantly faster than setting <see cref="TorrentManagerFile.Priority"/> on each file.
+    /// </summary>
+    /// <param name="priorities">The priorities to apply, indexed by <see cref="TorrentFileInfo.Index"/>. Any files not included are reset to <see cref="FileDownloadPriority.Normal"/></param>
+    public unsafe void SetFilePriorities(ReadOnlySpan<FileDownloadPriority> priorities)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        fixed (FileDownloadPriority* prioritiesPtr = priorities)
+        {
+            NativeMethods.SetFilePriorities(TorrentSessionHandle, prioritiesPtr, priorities.Length);
+        }
+    }
+
+    /// <summary>
+    /// Sets the download priority of a subset of files at once, leaving the rest unchanged.
+    /// </summary>
+    /// <param name="priorities">The new priorities, keyed by <see cref="TorrentFileInfo.Index"/></param>
+    public unsafe void UpdateFilePriorities(IReadOnlyDictionary<int, FileDownloadPriority> priorities)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        var updates = new NativeStructs.FilePriorityUpdate[priorities.Count];
+        var index = 0;
+
+        foreach (var (fileIndex, priority) in priorities)
+        {
+            updates[index++] = new NativeStructs.FilePriorityUpdate
+            {
+                file_index = fileIndex,
+                priority = priority
+            };
+        }
+
+        fixed (NativeStructs.FilePriorityUpdate* updatesPtr = updates)
+        {
+            NativeMethods.SetFilePrioritiesSparse(TorrentSessionHandle, updatesPtr, updates.Length);
+        }
+    }
+
+    /// <summary>
+    /// Reads a downloaded piece back from disk, raised as a <see cref="Alerts.PieceReadAlert"/> once complete.
+    /// Only pieces that have been downloaded and verified can be read.
+    /// </summary>
+    /// <param name="pieceIndex">The index of the piece to read</param>
+    public void ReadPiece(int pieceIndex)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+        NativeMethods.ReadPiece(TorrentSessionHandle, pieceIndex);
+    }
+
+    /// <summary>
+    /// Opens a <see cref="TorrentStream"/> over a file, prioritising the pieces just ahead of the reader so it can be played back while downloading.
+    /// </summary>
+    /// <remarks>
+    /// The rest of the file's pieces are given top priority while the stream is open, and restored when it's disposed.
+    /// Other files in the torrent keep downloading in their usual order.
+    /// </remarks>
+    /// <param name="file">The file to stream</param>
+    /// <param name="readAheadBytes">How far ahead of the reader pieces should be prioritised</param>
+    /// <param name="deadlineStep">The gap between the deadlines of consecutive pieces in the window. Defaults to 100ms</param>
+    /// <exception cref="InvalidOperationException">The stream could not be opened</exception>
+    public TorrentStream OpenStream(TorrentManagerFile file, long readAheadBytes = 8 * 1024 * 1024, TimeSpan? deadlineStep = null)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        if (readAheadBytes <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(readAheadBytes), "Read-ahead must be a positive value.");
+        }
+
+        var step = (int)(deadlineStep ?? TimeSpan.FromMilliseconds(100)).TotalMilliseconds;
+        var handle = NativeMethods.OpenTorrentStream(TorrentSessionHandle, file.Info.Index, readAheadBytes, step);
+
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to open stream. Ensure the file belongs to this torrent.");
+        }
+
+        return new TorrentStream(handle, file);
+    }
+
+    /// <summary>
+    /// Gets the number of bytes downloaded for every file in the torrent, indexed by <see cref="TorrentFileInfo.Index"/>.
+    /// </summary>
+    /// <remarks>
+    /// Progress for all files is collected in a single call, so prefer this over checking files individually.
+    /// </remarks>
+    /// <param name="pieceGranularity">Only count complete pieces. Less precise, but much cheaper for torrents with a large number of files</param>
+    public unsafe long[] GetFileProgress(bool pieceGranularity = true)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        var progress = new long[Info.Metadata.TotalFiles];
+
+        fixed (long* progressPtr = progress)
+        {
+            NativeMethods.GetFileProgress(TorrentSessionHandle, progressPtr, progress.Length, pieceGranularity);
+        }
+
+        return progress;
+    }
+
+    /// <summary>
+    /// Requests resume data for the torrent, raised as a <see cref="Alerts.ResumeDataAlert"/> once ready.
+    /// </summary>
+    /// <param name="flags">Options controlling what is saved</param>
+    public void RequestResumeData(ResumeDataFlags flags = ResumeDataFlags.None)
+    {
+        ObjectDisposedException.ThrowIf(_detached, this);
+        NativeMethods.SaveResumeData(TorrentSessionHandle, flags);
+    }
+
     /// <summary>
     /// Starts or resumes the torrent.
     /// </summary>
@@ -85,6 +271,18 @@ public class TorrentManager
         NativeMethods.ReannounceTorrent(TorrentSessionHandle, (int)interval.TotalSeconds, force);
     }
 
+    /// <summary>
+    /// Connects directly to a peer, without waiting for it to be found through a tracker or the DHT.
+    /// </summary>
+    /// <param name="endpoint">The peer's address and listening port</param>
+    public void ConnectPeer(IPEndPoint endpoint)
+    {
+        ArgumentNullException.ThrowIfNull(endpoint);
+        ObjectDisposedException.ThrowIf(_detached, this);
+
+        NativeMethods.ConnectPeer(TorrentSessionHandle, endpoint.Address.ToString(), endpoint.Port);
+    }
+
     // internal method to trigger a detached status, essentially making the object functionally unusable.
     internal void MarkAsDetached()
     {
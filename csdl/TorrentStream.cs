@@ -0,0 +1,105 @@
+// csdl - a cross-platform libtorrent wrapper for .NET
+// Licensed under Apache-2.0 - see the license file for more information
+
+using System;
+using csdl.Native;
+
+namespace csdl;
+
+/// <summary>
+/// Playback metrics for a <see cref="TorrentStream"/>.
+/// </summary>
+/// <param name="Position">The reader's current position within the file</param>
+/// <param name="WindowFirstPiece">The first piece in the read-ahead window</param>
+/// <param name="WindowLastPiece">The last piece in the read-ahead window</param>
+/// <param name="TimeToFirstByte">The time between opening the stream and the first byte becoming readable, or null if it hasn't yet</param>
+/// <param name="StallCount">The number of times the reader was left waiting on data after playback started</param>
+/// <param name="StallTime">The total time spent waiting on data after playback started</param>
+/// <param name="SeekCount">The number of times the reader jumped outside the read-ahead window</param>
+public record TorrentStreamStats(long Position, int WindowFirstPiece, int WindowLastPiece, TimeSpan? TimeToFirstByte, int StallCount, TimeSpan StallTime, int SeekCount);
+
+/// <summary>
+/// Keeps the pieces just ahead of a reader prioritised, allowing a file to be played back while it downloads.
+/// </summary>
+/// <remarks>
+/// The data itself is read from <see cref="File"/> on disk, checking <see cref="AvailableBytes"/> first.
+/// Streams are intended to be used by a single reader, and are not thread-safe.
+/// </remarks>
+public class TorrentStream : IDisposable
+{
+    private readonly IntPtr _handle;
+    private bool _disposed;
+
+    internal TorrentStream(IntPtr handle, TorrentManager.TorrentManagerFile file)
+    {
+        _handle = handle;
+        File = file;
+    }
+
+    ~TorrentStream()
+    {
+        Dispose();
+    }
+
+    /// <summary>
+    /// The file being streamed.
+    /// </summary>
+    public TorrentManager.TorrentManagerFile File { get; }
+
+    /// <summary>
+    /// Gets or sets the reader's position within the file.
+    /// The read-ahead window follows the reader, so this should be updated as data is read as well as when seeking.
+    /// </summary>
+    public long Position
+    {
+        get => GetStats().Position;
+        set
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            NativeMethods.SeekTorrentStream(_handle, value);
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of bytes that can be read from <see cref="Position"/> without waiting on the download.
+    /// A result of zero after playback has started counts as a stall.
+    /// </summary>
+    public long AvailableBytes
+    {
+        get
+        {
+            ObjectDisposedException.ThrowIf(_disposed, this);
+            return NativeMethods.GetTorrentStreamAvailable(_handle);
+        }
+    }
+
+    /// <summary>
+    /// Gets the playback metrics for the stream.
+    /// </summary>
+    public TorrentStreamStats GetStats()
+    {
+        ObjectDisposedException.ThrowIf(_disposed, this);
+        NativeMethods.GetTorrentStreamStats(_handle, out var stats);
+
+        return new TorrentStreamStats(stats.position,
+            stats.window_first_piece,
+            stats.window_last_piece,
+            stats.time_to_first_byte_ms < 0 ? null : TimeSpan.FromMilliseconds(stats.time_to_first_byte_ms),
+            stats.stall_count,
+            TimeSpan.FromMilliseconds(stats.stall_time_ms),
+            stats.seek_count);
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        NativeMethods.CloseTorrentStream(_handle);
+
+        GC.SuppressFinalize(this);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+//
+// bench_harness.hpp - timing and result output for csdl_bench
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_BENCH_HARNESS_HPP
+#define CS_NATIVE_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// a single benchmark result, written to stdout as one json object per line.
+// extra holds case-specific values (throughput, memory etc.) alongside the timings.
+struct bench_result {
+    std::string name;
+    int64_t iterations = 0;
+
+    int64_t min_ns = 0;
+    int64_t median_ns = 0;
+    int64_t p99_ns = 0;
+    int64_t max_ns = 0;
+    int64_t mean_ns = 0;
+
+    std::vector<std::pair<std::string, double>> extra;
+};
+
+class bench_runner {
+
+public:
+    explicit bench_runner(std::string filter) : filter_(std::move(filter)) {
+    }
+
+    // whether a case should run, based on the substring passed with --filter
+    bool selected(const std::string &name) const {
+        return filter_.empty() || name.find(filter_) != std::string::npos;
+    }
+
+    // times each call to fn after a single warmup call. fn is passed the iteration number.
+    template<typename F>
+    bench_result measure(const std::string &name, int64_t iterations, F &&fn) const {
+        std::vector<int64_t> samples;
+        samples.reserve(iterations);
+
+        fn(int64_t{-1});
+
+        for (int64_t i = 0; i < iterations; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            fn(i);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+
+        return summarise(name, samples);
+    }
+
+    static bench_result summarise(const std::string &name, std::vector<int64_t> &samples) {
+        bench_result result;
+        result.name = name;
+        result.iterations = static_cast<int64_t>(samples.size());
+
+        if (samples.empty()) {
+            return result;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        int64_t total = 0;
+        for (auto sample: samples) {
+            total += sample;
+        }
+
+        result.min_ns = samples.front();
+        result.median_ns = samples[samples.size() / 2];
+        result.p99_ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        result.max_ns = samples.back();
+        result.mean_ns = total / result.iterations;
+
+        return result;
+    }
+
+    static void report(const bench_result &result) {
+        std::printf(R"({"name":"%s","iterations":%lld,"min_ns":%lld,"median_ns":%lld,"p99_ns":%lld,"max_ns":%lld,"mean_ns":%lld)",
+                    json_escape(result.name).c_str(),
+                    static_cast<long long>(result.iterations),
+                    static_cast<long long>(result.min_ns),
+                    static_cast<long long>(result.median_ns),
+                    static_cast<long long>(result.p99_ns),
+                    static_cast<long long>(result.max_ns),
+                    static_cast<long long>(result.mean_ns));
+
+        for (const auto &[key, value]: result.extra) {
+            std::printf(R"(,"%s":%.3f)", json_escape(key).c_str(), value);
+        }
+
+        std::printf("}\n");
+        std::fflush(stdout);
+    }
+
+private:
+    // names come from fixture file names, so may contain anything a path can
+    static std::string json_escape(const std::string &value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+
+        for (const auto c: value) {
+            switch (c) {
+                case '"':
+                    escaped += "\\\"";
+                    break;
+
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[7];
+                        std::snprintf(code, sizeof(code), "\\u%04x", c);
+                        escaped += code;
+                    } else {
+                        escaped += c;
+                    }
+            }
+        }
+
+        return escaped;
+    }
+
+    std::string filter_;
+};
+
+#endif //CS_NATIVE_BENCH_HARNESS_HPP
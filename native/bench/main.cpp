@@ -0,0 +1,523 @@
+//
+// main.cpp - csdl_bench, benchmarks for the native wrapper
+// Created by Albie on 17/10/2026.
+//
+// usage: csdl_bench [--filter <substring>] [--fixtures <dir>] [--torrents <count>] [--alerts <count>] [--sessions <count>]
+// results are written to stdout as one json object per line, so runs can be diffed or collected over time.
+//
+
+#include "bench_harness.hpp"
+#include "process_stats.hpp"
+#include "library.h"
+#include "settings.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#include <libtorrent/bencode.hpp>
+#include <libtorrent/create_torrent.hpp>
+#include <libtorrent/torrent_info.hpp>
+
+#ifndef CSDL_BENCH_FIXTURES
+#define CSDL_BENCH_FIXTURES "csdl.Tests/files"
+#endif
+
+namespace {
+    struct bench_options {
+        std::string filter;
+        std::filesystem::path fixtures = CSDL_BENCH_FIXTURES;
+
+        int32_t torrents = 500;
+        int32_t alerts = 20000;
+        int32_t sessions = 4;
+    };
+
+    std::vector<char> read_file(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    // bencoded v1 torrent with file_count files, spread over directories of 1000.
+    // piece hashes are left as a fixed pattern - they're never checked against any data.
+    std::vector<char> make_synthetic_torrent(const std::string &name, int32_t file_count, int64_t file_size) {
+        lt::file_storage files;
+
+        for (int32_t i = 0; i < file_count; i++) {
+            files.add_file(name + "/dir-" + std::to_string(i / 1000) + "/file-" + std::to_string(i) + ".bin", file_size);
+        }
+
+        lt::create_torrent torrent(files, 4 * 1024 * 1024, lt::create_torrent::v1_only);
+        const std::string pattern(lt::sha1_hash::size(), '\xab');
+        const lt::sha1_hash hash(pattern.data());
+
+        for (lt::piece_index_t i(0); i < lt::piece_index_t(torrent.num_pieces()); ++i) {
+            torrent.set_hash(i, hash);
+        }
+
+        std::vector<char> buffer;
+        lt::bencode(std::back_inserter(buffer), torrent.generate());
+
+        return buffer;
+    }
+
+    // count copies of a fixture with its file layout and piece hashes, renamed so each one has its own info hash
+    std::vector<std::vector<char>> make_fixture_copies(const std::filesystem::path &path, int32_t count) {
+        const lt::torrent_info fixture(path.string());
+        std::vector<std::vector<char>> copies(count);
+
+        for (int32_t i = 0; i < count; i++) {
+            auto files = fixture.files();
+            files.set_name(fixture.name() + "-" + std::to_string(i));
+
+            lt::create_torrent torrent(files, fixture.piece_length(), lt::create_torrent::v1_only);
+
+            for (lt::piece_index_t piece(0); piece < lt::piece_index_t(fixture.num_pieces()); ++piece) {
+                torrent.set_hash(piece, fixture.hash_for_piece(piece));
+            }
+
+            lt::bencode(std::back_inserter(copies[i]), torrent.generate());
+        }
+
+        return copies;
+    }
+
+    cs_torrent_info *parse(const std::vector<char> &data) {
+        return create_torrent_bytes(data.data(), static_cast<long>(data.size()));
+    }
+
+    // a session that stays off the network, so timings aren't skewed by peers or port mapping
+    cs_session *create_quiet_session() {
+        auto pack = create_settings_pack();
+
+        settings_pack_set_str(pack, "listen_interfaces", "127.0.0.1:0");
+        settings_pack_set_bool(pack, "enable_dht", false);
+        settings_pack_set_bool(pack, "enable_lsd", false);
+        settings_pack_set_bool(pack, "enable_upnp", false);
+        settings_pack_set_bool(pack, "enable_natpmp", false);
+        settings_pack_set_int(pack, "alert_queue_size", 1 << 17);
+
+        auto session = create_session(pack);
+        destroy_settings_pack(pack);
+
+        return session;
+    }
+
+    void bench_parsing(const bench_runner &runner, const bench_options &options) {
+        std::error_code ec;
+
+        for (const auto &entry: std::filesystem::directory_iterator(options.fixtures, ec)) {
+            if (entry.path().extension() != ".torrent") {
+                continue;
+            }
+
+            const auto name = "parse/" + entry.path().filename().string();
+            if (!runner.selected(name)) {
+                continue;
+            }
+
+            const auto data = read_file(entry.path());
+            auto result = runner.measure(name, 200, [&](int64_t) {
+                destroy_torrent(parse(data));
+            });
+
+            result.extra.emplace_back("bytes", static_cast<double>(data.size()));
+            bench_runner::report(result);
+        }
+
+        if (ec) {
+            std::fprintf(stderr, "could not read fixtures from %s: %s\n", options.fixtures.string().c_str(), ec.message().c_str());
+        }
+
+        if (runner.selected("parse/synthetic-100k")) {
+            const auto data = make_synthetic_torrent("synthetic-100k", 100000, 64 * 1024);
+            auto result = runner.measure("parse/synthetic-100k", 5, [&](int64_t) {
+                destroy_torrent(parse(data));
+            });
+
+            result.extra.emplace_back("bytes", static_cast<double>(data.size()));
+            bench_runner::report(result);
+        }
+    }
+
+    void bench_file_list(const bench_runner &runner) {
+        if (!runner.selected("file_list/full-100k") && !runner.selected("file_list/range-1k")) {
+            return;
+        }
+
+        auto torrent = parse(make_synthetic_torrent("file-list-100k", 100000, 64 * 1024));
+
+        if (runner.selected("file_list/full-100k")) {
+            bench_runner::report(runner.measure("file_list/full-100k", 20, [&](int64_t) {
+                torrent_file_list list{};
+
+                get_torrent_file_list(torrent, &list);
+                destroy_torrent_file_list(&list);
+            }));
+        }
+
+        if (runner.selected("file_list/range-1k")) {
+            bench_runner::report(runner.measure("file_list/range-1k", 200, [&](int64_t i) {
+                torrent_file_list list{};
+
+                // walk through the list rather than hitting the same page every time
+                get_torrent_file_list_range(torrent, static_cast<int32_t>((std::max<int64_t>(i, 0) * 1000) % 99000), 1000, &list);
+                destroy_torrent_file_list(&list);
+            }));
+        }
+
+        destroy_torrent(torrent);
+    }
+
+    void bench_settings(const bench_runner &runner) {
+        if (!runner.selected("settings/build-client-config")) {
+            return;
+        }
+
+        // the same keys TorrentClientConfig sets
+        bench_runner::report(runner.measure("settings/build-client-config", 10000, [](int64_t) {
+            auto pack = create_settings_pack();
+
+            settings_pack_set_str(pack, "user_agent", "csdl/1.2.2");
+            settings_pack_set_str(pack, "peer_fingerprint", "-CS1220-");
+            settings_pack_set_int(pack, "alert_mask", 0x7fffffff);
+            settings_pack_set_bool(pack, "anonymous_mode", false);
+            settings_pack_set_bool(pack, "seeding_outgoing_connections", true);
+            settings_pack_set_int(pack, "connections_limit", 500);
+            settings_pack_set_int(pack, "out_enc_policy", 0);
+            settings_pack_set_int(pack, "in_enc_policy", 0);
+
+            destroy_settings_pack(pack);
+        }));
+    }
+
+    void bench_status(const bench_runner &runner, const bench_options &options) {
+        const auto count = options.torrents;
+        const auto sweep_name = "status/per-torrent-" + std::to_string(count);
+        const auto bulk_name = "status/bulk-" + std::to_string(count);
+
+        if (!runner.selected("attach/synthetic") && !runner.selected(sweep_name) && !runner.selected(bulk_name)) {
+            return;
+        }
+
+        const auto save_path = (std::filesystem::temp_directory_path() / "csdl-bench").string();
+
+        // parse everything up-front so the memory measurement only covers attaching
+        std::vector<cs_torrent_info *> torrents;
+        std::vector<lt::torrent_handle *> handles;
+
+        for (int32_t i = 0; i < count; i++) {
+            torrents.push_back(parse(make_synthetic_torrent("status-" + std::to_string(i), 4, 16 * 1024 * 1024)));
+        }
+
+        auto session = create_quiet_session();
+        std::vector<int64_t> samples;
+
+        const auto rss_before = resident_bytes();
+
+        for (auto torrent: torrents) {
+            const auto start = std::chrono::steady_clock::now();
+            handles.push_back(attach_torrent(session, torrent, save_path.c_str()));
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        const auto rss_after = resident_bytes();
+
+        if (runner.selected("attach/synthetic")) {
+            auto result = bench_runner::summarise("attach/synthetic", samples);
+
+            if (rss_before >= 0 && rss_after >= 0) {
+                result.extra.emplace_back("rss_bytes_per_torrent", static_cast<double>(rss_after - rss_before) / count);
+            }
+
+            bench_runner::report(result);
+        }
+
+        // one iteration is a status read for every attached torrent
+        if (runner.selected(sweep_name)) {
+            bench_runner::report(runner.measure(sweep_name, 20, [&](int64_t) {
+                torrent_status status{};
+
+                for (auto handle: handles) {
+                    get_torrent_status(handle, &status);
+                }
+            }));
+        }
+
+        if (runner.selected(bulk_name)) {
+            std::vector<torrent_status_entry> statuses(count);
+
+            bench_runner::report(runner.measure(bulk_name, 20, [&](int64_t) {
+                get_all_torrent_status(session, statuses.data(), count);
+            }));
+        }
+
+        for (auto handle: handles) {
+            detach_torrent(session, handle);
+        }
+
+        for (auto torrent: torrents) {
+            destroy_torrent(torrent);
+        }
+
+        destroy_session(session);
+
+        std::error_code ec;
+        std::filesystem::remove_all(save_path, ec);
+    }
+
+    // attaches --torrents copies of each fixture, either keeping every cs_torrent_info alive or freeing it straight after attaching.
+    // the torrents share the parsed metadata rather than copying it, so attached_bytes_per_torrent should stay well under
+    // parsed_bytes_per_torrent in both cases, and freeing the handles shouldn't change it.
+    void bench_shared_metadata(const bench_runner &runner, const bench_options &options) {
+        std::error_code ec;
+
+        for (const auto &entry: std::filesystem::directory_iterator(options.fixtures, ec)) {
+            if (entry.path().extension() != ".torrent") {
+                continue;
+            }
+
+            for (const auto keep: {true, false}) {
+                const auto name = (keep ? "attach/kept-" : "attach/freed-") + entry.path().filename().string();
+
+                if (!runner.selected(name)) {
+                    continue;
+                }
+
+                const auto copies = make_fixture_copies(entry.path(), options.torrents);
+                const auto save_path = (std::filesystem::temp_directory_path() / "csdl-bench").string();
+
+                auto session = create_quiet_session();
+
+                std::vector<cs_torrent_info *> torrents;
+                std::vector<lt::torrent_handle *> handles;
+                std::vector<int64_t> samples;
+
+                const auto rss_start = resident_bytes();
+
+                for (const auto &copy: copies) {
+                    torrents.push_back(parse(copy));
+                }
+
+                const auto rss_parsed = resident_bytes();
+
+                for (auto &torrent: torrents) {
+                    const auto start = std::chrono::steady_clock::now();
+                    handles.push_back(attach_torrent(session, torrent, save_path.c_str()));
+
+                    if (!keep) {
+                        destroy_torrent(torrent);
+                        torrent = nullptr;
+                    }
+
+                    samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+                }
+
+                const auto rss_attached = resident_bytes();
+                auto result = bench_runner::summarise(name, samples);
+
+                if (rss_start >= 0 && rss_parsed >= 0 && rss_attached >= 0) {
+                    result.extra.emplace_back("parsed_bytes_per_torrent", static_cast<double>(rss_parsed - rss_start) / options.torrents);
+                    result.extra.emplace_back("attached_bytes_per_torrent", static_cast<double>(rss_attached - rss_parsed) / options.torrents);
+                }
+
+                bench_runner::report(result);
+
+                for (auto handle: handles) {
+                    detach_torrent(session, handle);
+                }
+
+                for (auto torrent: torrents) {
+                    destroy_torrent(torrent);
+                }
+
+                destroy_session(session);
+
+                std::error_code remove_ec;
+                std::filesystem::remove_all(save_path, remove_ec);
+            }
+        }
+    }
+
+    // posts that many session_stats alerts to a polling session, then polls until they've all come out (or the deadline passes).
+    // returns the number received.
+    int64_t run_alert_storm(cs_session *session, int32_t alerts, std::chrono::steady_clock::time_point deadline) {
+        std::vector<cs_alert_record> records(1024);
+        int64_t received = 0;
+
+        for (int32_t i = 0; i < alerts; i++) {
+            post_session_stats(session);
+        }
+
+        while (received < alerts && std::chrono::steady_clock::now() < deadline) {
+            const auto count = poll_alerts(session, records.data(), static_cast<int32_t>(records.size()));
+
+            for (int32_t i = 0; i < count; i++) {
+                if (records[i].alert.type == alert_session_stats) {
+                    received++;
+                }
+            }
+
+            if (count == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        return received;
+    }
+
+    // floods the session with session_stats alerts and times how long they take to come out of poll_alerts
+    void bench_alert_storm(const bench_runner &runner, const bench_options &options) {
+        const auto name = "alerts/storm-" + std::to_string(options.alerts);
+
+        if (!runner.selected(name)) {
+            return;
+        }
+
+        auto session = create_quiet_session();
+        set_event_polling(session, 1 << 16, event_flags_none);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto received = run_alert_storm(session, options.alerts, start + std::chrono::seconds(30));
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        bench_result result;
+        result.name = name;
+        result.iterations = received;
+        result.mean_ns = received > 0 ? elapsed / received : 0;
+
+        result.extra.emplace_back("alerts_per_sec", elapsed > 0 ? received * 1e9 / static_cast<double>(elapsed) : 0);
+        result.extra.emplace_back("dropped", static_cast<double>(get_dropped_alert_count(session)));
+
+        bench_runner::report(result);
+        destroy_session(session);
+    }
+
+    // the same storm on several sessions at once, each drained by its own pump and polled from its own thread.
+    // the timings are how long each session took to get through its alerts, so they should stay flat as sessions are added.
+    void bench_session_scaling(const bench_runner &runner, const bench_options &options) {
+        for (auto session_count: {1, options.sessions}) {
+            const auto name = "alerts/sessions-" + std::to_string(session_count);
+
+            if (!runner.selected(name)) {
+                continue;
+            }
+
+            std::vector<cs_session *> sessions;
+
+            for (int32_t i = 0; i < session_count; i++) {
+                sessions.push_back(create_quiet_session());
+                set_event_polling(sessions.back(), 1 << 16, event_flags_none);
+            }
+
+            std::vector<int64_t> received(session_count);
+            std::vector<int64_t> samples(session_count);
+            std::vector<std::thread> threads;
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto deadline = start + std::chrono::seconds(60);
+
+            for (int32_t i = 0; i < session_count; i++) {
+                threads.emplace_back([&, i] {
+                    received[i] = run_alert_storm(sessions[i], options.alerts, deadline);
+                    samples[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                });
+            }
+
+            for (auto &thread: threads) {
+                thread.join();
+            }
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            int64_t total_received = 0, dropped = 0;
+            int64_t wakeups = 0, wakeup_latency_total_ns = 0, wakeup_latency_max_ns = 0;
+            double slowest_session_rate = 0;
+
+            for (int32_t i = 0; i < session_count; i++) {
+                cs_alert_pump_stats stats{};
+                get_alert_pump_stats(sessions[i], &stats);
+
+                total_received += received[i];
+                dropped += get_dropped_alert_count(sessions[i]);
+
+                wakeups += stats.wakeups;
+                wakeup_latency_total_ns += stats.wakeup_latency_total_ns;
+                wakeup_latency_max_ns = std::max(wakeup_latency_max_ns, stats.wakeup_latency_max_ns);
+
+                const auto rate = samples[i] > 0 ? received[i] * 1e9 / static_cast<double>(samples[i]) : 0;
+                slowest_session_rate = i == 0 ? rate : std::min(slowest_session_rate, rate);
+            }
+
+            // one sample per session: the time it took to drain all of its alerts
+            auto result = bench_runner::summarise(name, samples);
+
+            result.extra.emplace_back("sessions", session_count);
+            result.extra.emplace_back("alerts_per_sec", elapsed > 0 ? total_received * 1e9 / static_cast<double>(elapsed) : 0);
+            result.extra.emplace_back("slowest_session_alerts_per_sec", slowest_session_rate);
+            result.extra.emplace_back("wakeup_latency_mean_ns", wakeups > 0 ? static_cast<double>(wakeup_latency_total_ns) / wakeups : 0);
+            result.extra.emplace_back("wakeup_latency_max_ns", static_cast<double>(wakeup_latency_max_ns));
+            result.extra.emplace_back("dropped", static_cast<double>(dropped));
+
+            bench_runner::report(result);
+
+            for (auto session: sessions) {
+                destroy_session(session);
+            }
+
+            // --sessions 1 would run the same case twice
+            if (options.sessions == 1) {
+                break;
+            }
+        }
+    }
+
+    bool parse_options(int argc, char **argv, bench_options &options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            if (arg == "--filter") {
+                options.filter = argv[++i];
+            } else if (arg == "--fixtures") {
+                options.fixtures = argv[++i];
+            } else if (arg == "--torrents") {
+                options.torrents = std::max(1, std::atoi(argv[++i]));
+            } else if (arg == "--alerts") {
+                options.alerts = std::max(1, std::atoi(argv[++i]));
+            } else if (arg == "--sessions") {
+                options.sessions = std::max(1, std::atoi(argv[++i]));
+            } else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    bench_options options;
+
+    if (!parse_options(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--filter <substring>] [--fixtures <dir>] [--torrents <count>] [--alerts <count>] [--sessions <count>]\n", argv[0]);
+        return 1;
+    }
+
+    const bench_runner runner(options.filter);
+
+    bench_parsing(runner, options);
+    bench_file_list(runner);
+    bench_settings(runner);
+    bench_status(runner, options);
+    bench_shared_metadata(runner, options);
+    bench_alert_storm(runner, options);
+    bench_session_scaling(runner, options);
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+//
+// process_stats.hpp - process memory and cpu usage for the benchmark targets
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_BENCH_PROCESS_STATS_HPP
+#define CS_NATIVE_BENCH_PROCESS_STATS_HPP
+
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <sys/resource.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// resident set size of the process, or -1 where it can't be read
+inline int64_t resident_bytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<int64_t>(counters.WorkingSetSize);
+    }
+#elif defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+        return static_cast<int64_t>(info.resident_size);
+    }
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    int64_t size = 0, resident = 0;
+
+    if (statm >> size >> resident) {
+        return resident * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return -1;
+}
+
+// user + kernel time used by every thread in the process, or -1 where it can't be read
+inline int64_t cpu_time_ns() {
+#if defined(_WIN32)
+    FILETIME created, exited, kernel, user;
+
+    if (GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user)) {
+        auto ticks = [](const FILETIME &time) {
+            return (static_cast<int64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+
+        // filetimes are in 100ns units
+        return (ticks(kernel) + ticks(user)) * 100;
+    }
+#elif defined(__APPLE__) || defined(__linux__)
+    rusage usage{};
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        auto nanoseconds = [](const timeval &time) {
+            return static_cast<int64_t>(time.tv_sec) * 1000000000 + static_cast<int64_t>(time.tv_usec) * 1000;
+        };
+
+        return nanoseconds(usage.ru_utime) + nanoseconds(usage.ru_stime);
+    }
+#endif
+    return -1;
+}
+
+#endif //CS_NATIVE_BENCH_PROCESS_STATS_HPP
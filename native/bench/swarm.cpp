@@ -0,0 +1,502 @@
+//
+// swarm.cpp - csdl_swarm, end-to-end transfers between local sessions
+// Created by Albie on 17/10/2026.
+//
+// usage: csdl_swarm [--filter <substring>] [--size-mb <size>] [--leechers <count>] [--timeout <seconds>] [--dir <path>]
+// one seeding session and several leeching sessions are created on 127.0.0.1 and connected with connect_peer, so transfers
+// never leave the machine. each settings profile is run in turn, with results written as one json object per line.
+//
+
+#include "bench_harness.hpp"
+#include "process_stats.hpp"
+#include "library.h"
+#include "settings.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <variant>
+
+#include <libtorrent/bencode.hpp>
+#include <libtorrent/create_torrent.hpp>
+
+namespace {
+    using std::chrono::steady_clock;
+
+    struct swarm_options {
+        std::string filter;
+        std::filesystem::path directory = std::filesystem::temp_directory_path() / "csdl-swarm";
+
+        int64_t size_mb = 2048;
+        int32_t leechers = 3;
+        std::chrono::seconds timeout{600};
+    };
+
+    struct profile_setting {
+        const char *key;
+        std::variant<int, bool> value;
+    };
+
+    // settings_pack profiles to compare. every profile is applied on top of the loopback settings below.
+    struct settings_profile {
+        const char *name;
+        std::vector<profile_setting> settings;
+    };
+
+    const std::vector<settings_profile> profiles = {
+        {"default", {}},
+        {"low-memory", {
+            {"max_queued_disk_bytes", 256 * 1024},
+            {"send_buffer_watermark", 64 * 1024},
+            {"send_buffer_low_watermark", 16 * 1024},
+            {"max_out_request_queue", 50},
+            {"aio_threads", 1},
+            {"hashing_threads", 1}
+        }},
+        // along the lines of libtorrent's high_performance_seed()
+        {"high-throughput", {
+            {"max_queued_disk_bytes", 7 * 1024 * 1024},
+            {"send_buffer_watermark", 3 * 1024 * 1024},
+            {"send_buffer_low_watermark", 1024 * 1024},
+            {"send_buffer_watermark_factor", 150},
+            {"max_out_request_queue", 1500},
+            {"max_allowed_in_request_queue", 2000},
+            {"aio_threads", 8},
+            {"hashing_threads", 4}
+        }}
+    };
+
+    lt::settings_pack *build_settings(const settings_profile &profile) {
+        auto pack = create_settings_pack();
+
+        // keep to tcp over loopback, with nothing reaching out to the network
+        settings_pack_set_str(pack, "listen_interfaces", "127.0.0.1:0");
+        settings_pack_set_bool(pack, "enable_dht", false);
+        settings_pack_set_bool(pack, "enable_lsd", false);
+        settings_pack_set_bool(pack, "enable_upnp", false);
+        settings_pack_set_bool(pack, "enable_natpmp", false);
+        settings_pack_set_bool(pack, "enable_incoming_utp", false);
+        settings_pack_set_bool(pack, "enable_outgoing_utp", false);
+
+        // every peer shares an address
+        settings_pack_set_bool(pack, "allow_multiple_connections_per_ip", true);
+
+        for (const auto &setting: profile.settings) {
+            const auto applied = std::holds_alternative<bool>(setting.value)
+                                 ? settings_pack_set_bool(pack, setting.key, std::get<bool>(setting.value))
+                                 : settings_pack_set_int(pack, setting.key, std::get<int>(setting.value));
+
+            if (!applied) {
+                std::fprintf(stderr, "profile %s: unknown setting %s\n", profile.name, setting.key);
+            }
+        }
+
+        return pack;
+    }
+
+    cs_session *create_profile_session(const settings_profile &profile) {
+        auto pack = build_settings(profile);
+        auto session = create_session(pack);
+
+        destroy_settings_pack(pack);
+        return session;
+    }
+
+    // polls until check returns true, giving up at the deadline
+    bool wait_until(steady_clock::time_point deadline, const std::function<bool()> &check) {
+        while (!check()) {
+            if (steady_clock::now() >= deadline) {
+                return false;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+
+        return true;
+    }
+
+    int32_t wait_for_listen_port(cs_session *session) {
+        int32_t port = 0;
+        wait_until(steady_clock::now() + std::chrono::seconds(10), [&] { return (port = get_listen_port(session)) > 0; });
+
+        return port;
+    }
+
+    bool is_complete(lt::torrent_handle *handle) {
+        torrent_status status{};
+        get_torrent_status(handle, &status);
+
+        return status.state == torrent_seeding || status.state == torrent_finished;
+    }
+
+    // writes size_mb of pseudo-random data across four files, reusing files left by a previous run
+    void generate_content(const std::filesystem::path &root, int64_t size_mb) {
+        constexpr int file_count = 4;
+        constexpr size_t chunk_size = 1024 * 1024;
+
+        const auto file_size = size_mb * 1024 * 1024 / file_count;
+
+        std::vector<char> chunk(chunk_size);
+        uint64_t state = 0x9e3779b97f4a7c15;
+
+        std::filesystem::create_directories(root);
+
+        for (int i = 0; i < file_count; i++) {
+            const auto path = root / ("file-" + std::to_string(i) + ".bin");
+            std::error_code ec;
+
+            if (std::filesystem::file_size(path, ec) == static_cast<uintmax_t>(file_size)) {
+                continue;
+            }
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+            for (int64_t written = 0; written < file_size; written += chunk_size) {
+                // xorshift is plenty to stop anything along the way compressing or deduplicating the data
+                for (size_t offset = 0; offset < chunk_size; offset += sizeof(state)) {
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+
+                    std::memcpy(chunk.data() + offset, &state, sizeof(state));
+                }
+
+                file.write(chunk.data(), static_cast<std::streamsize>(std::min<int64_t>(chunk_size, file_size - written)));
+            }
+        }
+    }
+
+    std::vector<char> create_content_torrent(const std::filesystem::path &root) {
+        lt::file_storage files;
+        lt::add_files(files, root.string());
+
+        lt::create_torrent torrent(files, 0, lt::create_torrent::v1_only);
+        lt::error_code ec;
+
+        lt::set_piece_hashes(torrent, root.parent_path().string(), ec);
+
+        if (ec) {
+            std::fprintf(stderr, "failed to hash %s: %s\n", root.string().c_str(), ec.message().c_str());
+            return {};
+        }
+
+        std::vector<char> buffer;
+        lt::bencode(std::back_inserter(buffer), torrent.generate());
+
+        return buffer;
+    }
+
+    std::string make_magnet_uri(cs_torrent_info *torrent) {
+        constexpr char digits[] = "0123456789abcdef";
+
+        auto metadata = get_torrent_info(torrent);
+        std::string uri = "magnet:?xt=urn:btih:";
+
+        for (auto byte: metadata->info_hash_v1) {
+            uri += digits[byte >> 4];
+            uri += digits[byte & 0xf];
+        }
+
+        destroy_torrent_info(metadata);
+        return uri;
+    }
+
+    struct leecher {
+        cs_session *session = nullptr;
+        lt::torrent_handle *handle = nullptr;
+
+        std::filesystem::path save_path;
+        int32_t port = 0;
+    };
+
+    leecher create_leecher(const settings_profile &profile, const std::filesystem::path &save_path) {
+        leecher peer;
+
+        peer.session = create_profile_session(profile);
+        peer.save_path = save_path;
+        peer.port = wait_for_listen_port(peer.session);
+
+        std::error_code ec;
+        std::filesystem::remove_all(save_path, ec);
+
+        return peer;
+    }
+
+    void destroy_leecher(leecher &peer) {
+        if (peer.handle != nullptr) {
+            detach_torrent(peer.session, peer.handle);
+        }
+
+        destroy_session(peer.session);
+
+        std::error_code ec;
+        std::filesystem::remove_all(peer.save_path, ec);
+    }
+
+    class swarm {
+
+    public:
+        swarm(const swarm_options &options, std::vector<char> torrent)
+                : options_(options), torrent_data_(std::move(torrent)), torrent_(parse()) {
+            auto metadata = get_torrent_info(torrent_);
+
+            total_size_ = metadata->total_size;
+            destroy_torrent_info(metadata);
+        }
+
+        ~swarm() {
+            destroy_torrent(torrent_);
+
+            if (seed_ != nullptr) {
+                if (seed_handle_ != nullptr) {
+                    detach_torrent(seed_, seed_handle_);
+                }
+
+                destroy_session(seed_);
+            }
+        }
+
+        // the seed is created once and re-checks the content, later profiles are applied to it in place
+        bool start_seed(const std::filesystem::path &seed_path) {
+            seed_ = create_profile_session(profiles.front());
+            seed_port_ = wait_for_listen_port(seed_);
+            seed_handle_ = attach(seed_, seed_path);
+
+            if (seed_port_ <= 0 || seed_handle_ == nullptr) {
+                return false;
+            }
+
+            start_torrent(seed_handle_);
+            return wait_until(steady_clock::now() + options_.timeout, [this] { return is_complete(seed_handle_); });
+        }
+
+        // transfers the torrent to every leecher at once, reporting aggregate throughput and how long each leecher took
+        void run_transfer(const bench_runner &runner, const settings_profile &profile) {
+            const auto name = std::string("swarm/") + profile.name;
+
+            if (!runner.selected(name)) {
+                return;
+            }
+
+            auto pack = build_settings(profile);
+            apply_settings(seed_, pack);
+            destroy_settings_pack(pack);
+
+            std::vector<leecher> peers;
+
+            for (int32_t i = 0; i < options_.leechers; i++) {
+                auto peer = create_leecher(profile, options_.directory / ("leecher-" + std::to_string(i)));
+                peer.handle = attach(peer.session, peer.save_path);
+
+                peers.push_back(std::move(peer));
+            }
+
+            const auto cpu_before = cpu_time_ns();
+            const auto start = steady_clock::now();
+
+            // everyone connects to the seed and to each other, so leechers can trade pieces too
+            for (size_t i = 0; i < peers.size(); i++) {
+                start_torrent(peers[i].handle);
+                connect_peer(peers[i].handle, "127.0.0.1", seed_port_);
+
+                for (size_t j = 0; j < i; j++) {
+                    connect_peer(peers[i].handle, "127.0.0.1", peers[j].port);
+                }
+            }
+
+            std::vector<int64_t> completion_ns;
+            std::vector<bool> done(peers.size());
+            int64_t peak_rss = resident_bytes();
+
+            wait_until(start + options_.timeout, [&] {
+                for (size_t i = 0; i < peers.size(); i++) {
+                    if (!done[i] && is_complete(peers[i].handle)) {
+                        done[i] = true;
+                        completion_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count());
+                    }
+                }
+
+                // sampled rather than the process high-water mark, so each profile gets its own peak
+                peak_rss = std::max(peak_rss, resident_bytes());
+                return completion_ns.size() == peers.size();
+            });
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count();
+            const auto cpu_used = cpu_time_ns() - cpu_before;
+            const auto completed = static_cast<double>(completion_ns.size());
+
+            auto result = bench_runner::summarise(name, completion_ns);
+
+            result.extra.emplace_back("leechers", static_cast<double>(peers.size()));
+            result.extra.emplace_back("completed", completed);
+            result.extra.emplace_back("total_bytes", static_cast<double>(total_size_));
+            result.extra.emplace_back("mb_per_sec", total_size_ * completed / 1e6 / (elapsed / 1e9));
+            result.extra.emplace_back("elapsed_ms", elapsed / 1e6);
+            result.extra.emplace_back("cpu_time_ms", cpu_used / 1e6);
+            result.extra.emplace_back("peak_rss_bytes", static_cast<double>(peak_rss));
+
+            bench_runner::report(result);
+
+            for (auto &peer: peers) {
+                destroy_leecher(peer);
+            }
+        }
+
+        // time for a magnet link to fetch the info-dict from the seed
+        void run_magnet(const bench_runner &runner) {
+            if (!runner.selected("magnet/metadata")) {
+                return;
+            }
+
+            auto peer = create_leecher(profiles.front(), options_.directory / "magnet");
+            peer.handle = attach_magnet(peer.session, make_magnet_uri(torrent_).c_str(), peer.save_path.string().c_str());
+
+            const auto start = steady_clock::now();
+            cs_torrent_info *metadata = nullptr;
+
+            connect_peer(peer.handle, "127.0.0.1", seed_port_);
+            wait_until(start + options_.timeout, [&] { return (metadata = get_torrent_handle_info(peer.handle)) != nullptr; });
+
+            std::vector<int64_t> samples;
+
+            if (metadata != nullptr) {
+                samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count());
+                destroy_torrent(metadata);
+            }
+
+            bench_runner::report(bench_runner::summarise("magnet/metadata", samples));
+            destroy_leecher(peer);
+        }
+
+        // time for a stream opened halfway through a file to get its first readable byte
+        void run_stream(const bench_runner &runner) {
+            if (!runner.selected("stream/first-byte")) {
+                return;
+            }
+
+            auto peer = create_leecher(profiles.front(), options_.directory / "stream");
+            peer.handle = attach(peer.session, peer.save_path);
+
+            torrent_file_list files{};
+            get_torrent_file_list_range(torrent_, 0, 1, &files);
+
+            const auto file_size = files.length > 0 ? files.files[0].file_size : 0;
+            destroy_torrent_file_list(&files);
+
+            auto stream = open_torrent_stream(peer.handle, 0, 8 * 1024 * 1024, 50);
+            seek_torrent_stream(stream, file_size / 2);
+
+            start_torrent(peer.handle);
+            connect_peer(peer.handle, "127.0.0.1", seed_port_);
+
+            wait_until(steady_clock::now() + options_.timeout, [&] { return get_torrent_stream_available(stream) > 0; });
+
+            torrent_stream_stats stats{};
+            get_torrent_stream_stats(stream, &stats);
+
+            std::vector<int64_t> samples;
+
+            if (stats.time_to_first_byte_ms >= 0) {
+                samples.push_back(stats.time_to_first_byte_ms * 1000000);
+            }
+
+            auto result = bench_runner::summarise("stream/first-byte", samples);
+            result.extra.emplace_back("stall_count", stats.stall_count);
+            result.extra.emplace_back("window_pieces", stats.window_last_piece - stats.window_first_piece + 1);
+
+            bench_runner::report(result);
+
+            close_torrent_stream(stream);
+            destroy_leecher(peer);
+        }
+
+    private:
+        const swarm_options &options_;
+
+        std::vector<char> torrent_data_;
+        cs_torrent_info *torrent_;
+        int64_t total_size_ = 0;
+
+        cs_session *seed_ = nullptr;
+        lt::torrent_handle *seed_handle_ = nullptr;
+        int32_t seed_port_ = 0;
+
+        cs_torrent_info *parse() const {
+            return create_torrent_bytes(torrent_data_.data(), static_cast<long>(torrent_data_.size()));
+        }
+
+        // each session gets its own copy of the metadata rather than sharing one between them
+        lt::torrent_handle *attach(cs_session *session, const std::filesystem::path &save_path) const {
+            auto torrent = parse();
+            auto handle = attach_torrent(session, torrent, save_path.string().c_str());
+
+            destroy_torrent(torrent);
+            return handle;
+        }
+    };
+
+    bool parse_options(int argc, char **argv, swarm_options &options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+
+            if (i + 1 >= argc) {
+                return false;
+            }
+
+            if (arg == "--filter") {
+                options.filter = argv[++i];
+            } else if (arg == "--size-mb") {
+                options.size_mb = std::max(1LL, std::atoll(argv[++i]));
+            } else if (arg == "--leechers") {
+                options.leechers = std::max(1, std::atoi(argv[++i]));
+            } else if (arg == "--timeout") {
+                options.timeout = std::chrono::seconds(std::max(1, std::atoi(argv[++i])));
+            } else if (arg == "--dir") {
+                options.directory = argv[++i];
+            } else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char **argv) {
+    swarm_options options;
+
+    if (!parse_options(argc, argv, options)) {
+        std::fprintf(stderr, "usage: %s [--filter <substring>] [--size-mb <size>] [--leechers <count>] [--timeout <seconds>] [--dir <path>]\n", argv[0]);
+        return 1;
+    }
+
+    const bench_runner runner(options.filter);
+    const auto seed_path = options.directory / "seed";
+    const auto content_path = seed_path / ("swarm-" + std::to_string(options.size_mb) + "mb");
+
+    generate_content(content_path, options.size_mb);
+    auto torrent = create_content_torrent(content_path);
+
+    if (torrent.empty()) {
+        return 1;
+    }
+
+    swarm local(options, std::move(torrent));
+
+    if (!local.start_seed(seed_path)) {
+        std::fprintf(stderr, "seed did not become ready\n");
+        return 1;
+    }
+
+    for (const auto &profile: profiles) {
+        local.run_transfer(runner, profile);
+    }
+
+    local.run_magnet(runner);
+    local.run_stream(runner);
+
+    return 0;
+}
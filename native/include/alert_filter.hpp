@@ -0,0 +1,69 @@
+//
+// alert_filter.hpp - native-side alert filtering
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_ALERT_FILTER_HPP
+#define CS_NATIVE_ALERT_FILTER_HPP
+
+#include "events.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <libtorrent/alert.hpp>
+#include <libtorrent/info_hash.hpp>
+#include <libtorrent/torrent_handle.hpp>
+
+// immutable once built - sessions swap the whole filter when it changes, so drains can hold onto one without locking.
+class alert_filter {
+
+public:
+    // kept in the alert_mask whatever the filter allows. attach tracking, magnet completions and the managed client
+    // (see TorrentClient.RequiredAlertCategories) rely on these alerts being posted, even if they're never delivered.
+    static constexpr lt::alert_category_t retained_categories = lt::alert_category::status | lt::alert_category::storage;
+
+    // a default filter lets everything through
+    alert_filter() = default;
+    explicit alert_filter(const cs_alert_filter &filter);
+
+    bool allows(cs_alert_type type, const lt::alert *alert) const {
+        return allows(type, alert->category());
+    }
+
+    // for records that aren't converted from an alert of their own (see recover_dropped_attaches)
+    bool allows(cs_alert_type type, lt::alert_category_t categories) const {
+        if (!(alert_types_ & (1u << type))) {
+            return false;
+        }
+
+        auto category = static_cast<uint32_t>(categories);
+        return category == 0 || (category & category_mask_) != 0;
+    }
+
+    bool allows(cs_peer_alert_type type) const {
+        return peer_alert_types_ & (1u << type);
+    }
+
+    bool allows(const lt::info_hash_t &hashes) const {
+        return info_hashes_.empty() || std::binary_search(info_hashes_.begin(), info_hashes_.end(), hashes.v1);
+    }
+
+    // only looks up the handle's info hash if there's an allowlist to check against
+    bool allows(const lt::torrent_handle &handle) const {
+        return info_hashes_.empty() || allows(handle.info_hashes());
+    }
+
+    // the session alert_mask needed to produce every alert this filter can let through, plus retained_categories
+    lt::alert_category_t required_categories() const;
+
+private:
+    uint32_t alert_types_ = ~0u;
+    uint32_t peer_alert_types_ = ~0u;
+    uint32_t category_mask_ = ~0u;
+
+    // sorted, for binary searching
+    std::vector<lt::sha1_hash> info_hashes_;
+};
+
+#endif //CS_NATIVE_ALERT_FILTER_HPP
@@ -0,0 +1,82 @@
+//
+// alert_pump.hpp - long-lived alert dispatch thread
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_ALERT_PUMP_HPP
+#define CS_NATIVE_ALERT_PUMP_HPP
+
+#include "events.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// a single worker thread per session that drains alerts when libtorrent signals they are available.
+// notify() is called from libtorrent's alert_notify hook, so it must never block or call back into the session.
+class alert_pump {
+
+public:
+    typedef std::function<void()> drain_function;
+
+    alert_pump() = default;
+    ~alert_pump();
+
+    alert_pump(const alert_pump &) = delete;
+    alert_pump &operator=(const alert_pump &) = delete;
+
+    // replaces the drain function and starts the worker if it isn't already running.
+    void start(drain_function drain);
+
+    // stops the worker. if called from the worker itself (i.e. within an alert callback),
+    // the drain function is cleared and the thread is left idle until the next start() or destruction.
+    void stop();
+
+    // stops the worker from inside its own drain function (i.e. within an alert callback).
+    // once the drain returns, the worker detaches itself and runs on_exit as the last thing it does, so on_exit is free to destroy the pump.
+    void retire(std::function<void()> on_exit);
+
+    bool is_worker_thread() const;
+
+    // signal the worker that alerts are available
+    void notify();
+
+    // additionally run the drain function on a fixed interval, for time-based work. zero disables the timer.
+    void set_interval(std::chrono::milliseconds interval);
+
+    void get_stats(cs_alert_pump_stats *stats) const;
+
+private:
+    void run();
+    void join();
+
+    std::thread worker_;
+
+    std::mutex mutex_;
+    std::condition_variable signal_;
+
+    std::shared_ptr<const drain_function> drain_;
+    std::function<void()> on_exit_;
+
+    bool pending_ = false;
+    bool stopping_ = false;
+    bool rescheduled_ = false;
+
+    std::chrono::steady_clock::time_point notified_at_;
+
+    std::chrono::milliseconds interval_{0};
+    std::chrono::steady_clock::time_point next_tick_;
+
+    std::atomic<int64_t> threads_started_{0};
+    std::atomic<int64_t> notifications_{0};
+    std::atomic<int64_t> wakeups_{0};
+    std::atomic<int64_t> wakeup_latency_total_ns_{0};
+    std::atomic<int64_t> wakeup_latency_max_ns_{0};
+    std::atomic<int64_t> timer_ticks_{0};
+};
+
+#endif //CS_NATIVE_ALERT_PUMP_HPP
@@ -0,0 +1,157 @@
+//
+// alert_ring.hpp - lock-free single producer/single consumer alert queue
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_ALERT_RING_HPP
+#define CS_NATIVE_ALERT_RING_HPP
+
+#include "events.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/shared_array.hpp>
+#include <libtorrent/torrent_handle.hpp>
+
+// a slot owns copies of anything the record points at, so records remain valid after the originating alert is gone.
+struct alert_ring_slot {
+    cs_alert_record record;
+
+    std::string message;
+    lt::torrent_handle handle;
+    std::vector<torrent_status_entry> statuses;
+    std::vector<char> data;
+    std::vector<int64_t> counters;
+
+    // shares ownership of the piece rather than copying it
+    boost::shared_array<char> piece;
+};
+
+// fixed-capacity ring filled by the alert pump (producer) and drained by poll_alerts (consumer).
+// polled slots aren't handed back to the producer until the next poll, so the records copied out stay valid until then.
+class alert_ring {
+
+public:
+    explicit alert_ring(size_t capacity) {
+        size_t size = 1;
+
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        slots_ = std::make_unique<alert_ring_slot[]>(size);
+        mask_ = size - 1;
+    }
+
+    alert_ring(const alert_ring &) = delete;
+    alert_ring &operator=(const alert_ring &) = delete;
+
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+    int64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // producer: copy a converted record into the ring, taking ownership of anything it points to.
+    // returns false (and counts the record as dropped) if the ring is full.
+    bool push(const cs_alert_record &record) {
+        const auto head = head_.load(std::memory_order_relaxed);
+
+        if (head - tail_.load(std::memory_order_acquire) > mask_) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        auto &slot = slots_[head & mask_];
+        slot.record = record;
+
+        if (record.alert.message != nullptr) {
+            slot.message.assign(record.alert.message);
+            slot.record.alert.message = slot.message.c_str();
+        }
+
+        if (record.alert.type == cs_alert_type::alert_peer_notification && record.peer.handle != nullptr) {
+            slot.handle = *record.peer.handle;
+            slot.record.peer.handle = &slot.handle;
+        }
+
+        if (record.alert.type == cs_alert_type::alert_torrent_added && record.torrent_added.handle != nullptr) {
+            slot.handle = *record.torrent_added.handle;
+            slot.record.torrent_added.handle = &slot.handle;
+        }
+
+        if (record.alert.type == cs_alert_type::alert_metadata_received) {
+            slot.handle = *record.metadata_received.handle;
+            slot.record.metadata_received.handle = &slot.handle;
+        }
+
+        if (record.alert.type == cs_alert_type::alert_piece_read) {
+            slot.handle = *record.piece_read.handle;
+            slot.record.piece_read.handle = &slot.handle;
+
+            if (record.piece_read.buffer != nullptr) {
+                slot.piece = *record.piece_read.buffer;
+                slot.record.piece_read.buffer = &slot.piece;
+            }
+        }
+
+        if (record.alert.type == cs_alert_type::alert_resume_data) {
+            slot.handle = *record.resume_data.handle;
+            slot.record.resume_data.handle = &slot.handle;
+
+            if (record.resume_data.data != nullptr) {
+                slot.data.assign(record.resume_data.data, record.resume_data.data + record.resume_data.length);
+                slot.record.resume_data.data = slot.data.data();
+            }
+        }
+
+        if (record.alert.type == cs_alert_type::alert_session_stats) {
+            slot.counters.assign(record.session_stats.counters, record.session_stats.counters + record.session_stats.count);
+            slot.record.session_stats.counters = slot.counters.data();
+        }
+
+        if (record.alert.type == cs_alert_type::alert_torrent_status_updates) {
+            slot.statuses.assign(record.status_updates.statuses, record.status_updates.statuses + record.status_updates.count);
+            slot.record.status_updates.statuses = slot.statuses.data();
+        }
+
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer: release the previously polled slots, then copy out up to max records.
+    size_t poll(cs_alert_record *buffer, size_t max) {
+        tail_.store(read_, std::memory_order_release);
+
+        const auto head = head_.load(std::memory_order_acquire);
+        size_t count = 0;
+
+        while (read_ != head && count < max) {
+            buffer[count++] = slots_[read_ & mask_].record;
+            read_++;
+        }
+
+        return count;
+    }
+
+private:
+    std::unique_ptr<alert_ring_slot[]> slots_;
+    size_t mask_;
+
+    // written by the producer
+    alignas(64) std::atomic<size_t> head_{0};
+
+    // written by the consumer. read_ runs ahead of tail_ by the number of slots currently lent out
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t read_ = 0;
+
+    alignas(64) std::atomic<int64_t> dropped_{0};
+};
+
+#endif //CS_NATIVE_ALERT_RING_HPP
@@ -14,8 +14,10 @@
 
 #include "lib_export.h"
 #include "struct_align.h"
+#include "structs.h"
 
 #include <ctime>
+#include <boost/shared_array.hpp>
 #include <libtorrent/alert.hpp>
 #include <libtorrent/error_code.hpp>
 #include <libtorrent/torrent_status.hpp>
@@ -24,18 +26,40 @@
 // used internally in main library, not intended for public use
 typedef void (CALL_CONV *cs_alert_callback)(void *alert);
 
-CSDL_NO_EXPORT void on_events_available(lt::session *session, cs_alert_callback callback, bool include_unmapped);
+struct cs_session;
+
+CSDL_NO_EXPORT void on_events_available(cs_session *session);
+CSDL_NO_EXPORT void fill_info_hash(const lt::info_hash_t &hashes, char *buffer);
+CSDL_NO_EXPORT void fill_torrent_status(const lt::torrent_status &status, torrent_status *torrent_status);
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// flags controlling how alerts are delivered, passed to the set_event_* functions.
+enum cs_event_flags : uint32_t {
+    event_flags_none = 0,
+
+    // deliver alerts that aren't mapped as a generic cs_alert
+    event_include_unmapped = 1 << 0,
+
+    // populate cs_alert::message. formatting is relatively expensive, so it's left as null unless requested.
+    event_format_messages = 1 << 1
+};
+
 enum cs_alert_type : int32_t {
     alert_generic = 0,
     alert_torrent_status = 1,
     alert_client_performance = 2,
     alert_peer_notification = 3,
-    alert_torrent_removed = 4
+    alert_torrent_removed = 4,
+    alert_peer_summary = 5,
+    alert_torrent_status_updates = 6,
+    alert_torrent_added = 7,
+    alert_resume_data = 8,
+    alert_metadata_received = 9,
+    alert_piece_read = 10,
+    alert_session_stats = 11
 };
 
 // base format for all alerts
@@ -79,6 +103,9 @@ enum cs_peer_alert_type : uint8_t {
     errored = 6
 };
 
+#define CS_PEER_ALERT_TYPES 7
+#define CS_PEER_SUMMARY_TOP_ERRORS 4
+
 struct CSDL_STRUCT cs_peer_alert {
     cs_alert alert;
 
@@ -89,6 +116,154 @@ struct CSDL_STRUCT cs_peer_alert {
     char ipv6_address[16];
 };
 
+// peer activity for a single torrent, folded over a window (see set_peer_alert_aggregation)
+struct CSDL_STRUCT cs_peer_summary_alert {
+    cs_alert alert;
+
+    char info_hash[20];
+    int32_t window_ms;
+
+    // number of peer alerts raised in the window, indexed by cs_peer_alert_type
+    int32_t counts[CS_PEER_ALERT_TYPES];
+
+    // distinct peer endpoints seen in the window
+    int32_t unique_endpoints;
+
+    // the most frequent disconnect/error codes in the window, in descending order. unused entries have a count of zero.
+    // codes are counted per category, so the same code can appear more than once with different categories.
+    int32_t top_error_codes[CS_PEER_SUMMARY_TOP_ERRORS];
+    int32_t top_error_counts[CS_PEER_SUMMARY_TOP_ERRORS];
+
+    // the error category name of each code (e.g. "system", "libtorrent"). these are static and never freed.
+    const char *top_error_categories[CS_PEER_SUMMARY_TOP_ERRORS];
+};
+
+// torrents whose status changed since the previous update (see set_status_update_interval).
+// statuses follows the same lifetime rules as cs_alert::message.
+struct CSDL_STRUCT cs_torrent_status_update_alert {
+    cs_alert alert;
+
+    int32_t count;
+    const torrent_status_entry *statuses;
+};
+
+// raised once a torrent has been added to the session (or failed to be).
+struct CSDL_STRUCT cs_torrent_added_alert {
+    cs_alert alert;
+
+    // the id given to attach_torrents_async, or -1 if the torrent was attached some other way
+    int64_t request_id;
+
+    // null if the torrent couldn't be added. owned by the alert - use copy_torrent_handle to keep hold of it.
+    lt::torrent_handle *handle;
+    int32_t error_code;
+
+    char info_hash[20];
+};
+
+// the result of save_resume_data/save_all_resume_data for a single torrent.
+// data is the bencoded resume data to pass back when re-attaching the torrent, and follows the same lifetime rules as cs_alert::message.
+// on failure, data is null and error_code is set.
+struct CSDL_STRUCT cs_resume_data_alert {
+    cs_alert alert;
+
+    lt::torrent_handle *handle;
+    char info_hash[20];
+
+    const char *data;
+    int32_t length;
+
+    int32_t error_code;
+};
+
+// raised once a torrent attached from a magnet link has downloaded its metadata.
+// the metadata can be fetched with get_torrent_handle_info.
+struct CSDL_STRUCT cs_metadata_received_alert {
+    cs_alert alert;
+
+    // owned by the alert - use copy_torrent_handle to keep hold of it.
+    lt::torrent_handle *handle;
+    char info_hash[20];
+};
+
+// the result of read_piece. data points straight into libtorrent's piece buffer, and is only valid as long as buffer is.
+// buffer is owned by the alert - use copy_piece_buffer to keep the data alive after the alert has been processed.
+// on failure, data and buffer are null and error_code is set.
+struct CSDL_STRUCT cs_piece_read_alert {
+    cs_alert alert;
+
+    lt::torrent_handle *handle;
+    char info_hash[20];
+
+    int32_t piece;
+    int32_t size;
+
+    const char *data;
+    const boost::shared_array<char> *buffer;
+
+    int32_t error_code;
+};
+
+// a snapshot of the session's performance counters, requested with post_session_stats.
+// counters is indexed by the value_index of each entry in get_session_stats_metrics, and follows the same lifetime rules as cs_alert::message.
+struct CSDL_STRUCT cs_session_stats_alert {
+    cs_alert alert;
+
+    int32_t count;
+    const int64_t *counters;
+};
+
+// native-side alert filter, applied before any alert struct is built.
+struct CSDL_STRUCT cs_alert_filter {
+    // bitmask of (1 << cs_alert_type) values to deliver
+    uint32_t alert_types;
+
+    // bitmask of (1 << cs_peer_alert_type) values to deliver, when alert_peer_notification is allowed
+    uint32_t peer_alert_types;
+
+    // libtorrent alert categories to deliver, alerts without a category are always let through. set to -1 to allow all.
+    int32_t category_mask;
+
+    // optional allowlist of v1 info hashes (20 bytes each) for torrent-specific alerts. leave empty to allow all torrents.
+    int32_t info_hash_count;
+    const char *info_hashes;
+};
+
+// fixed-size record able to hold any mapped alert, tagged by alert.type.
+// used to deliver a batch of alerts as a single contiguous array.
+union CSDL_STRUCT cs_alert_record {
+    cs_alert alert;
+
+    cs_torrent_status_alert torrent_status;
+    cs_torrent_remove_alert torrent_removed;
+    cs_client_performance_alert performance;
+    cs_peer_alert peer;
+    cs_peer_summary_alert peer_summary;
+    cs_torrent_status_update_alert status_updates;
+    cs_torrent_added_alert torrent_added;
+    cs_resume_data_alert resume_data;
+    cs_metadata_received_alert metadata_received;
+    cs_piece_read_alert piece_read;
+    cs_session_stats_alert session_stats;
+};
+
+// receives every alert from a single pop_alerts call at once.
+// record_size is the stride between records, the array is only valid until the callback returns.
+typedef void (CALL_CONV *cs_alert_batch_callback)(cs_alert_record *alerts, int32_t count, int32_t record_size);
+
+// counters for the per-session alert pump thread
+struct CSDL_STRUCT cs_alert_pump_stats {
+    int64_t threads_started;
+    int64_t notifications;
+    int64_t wakeups;
+
+    int64_t wakeup_latency_total_ns;
+    int64_t wakeup_latency_max_ns;
+
+    // wakeups caused by the pump's own timer rather than libtorrent
+    int64_t timer_ticks;
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,51 @@
+//
+// instrumentation.hpp - opt-in latency histograms for the exported api
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_INSTRUMENTATION_HPP
+#define CS_NATIVE_INSTRUMENTATION_HPP
+
+#include "structs.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace instrumentation {
+    // relaxed flag checked by every instrumented call, so the disabled cost is a single load
+    extern std::atomic<bool> enabled;
+
+    // add a value to the calling thread's histogram for a metric
+    void record(cs_native_metric metric, int64_t value);
+
+    // sum every thread's histogram for a metric
+    void collect(cs_native_metric metric, native_histogram *histogram);
+}
+
+// records the lifetime of the enclosing scope against a metric, if instrumentation was enabled when it started.
+class call_timer {
+
+public:
+    explicit call_timer(cs_native_metric metric) : metric_(metric), active_(instrumentation::enabled.load(std::memory_order_relaxed)) {
+        if (active_) {
+            started_at_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~call_timer() {
+        if (active_) {
+            instrumentation::record(metric_, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started_at_).count());
+        }
+    }
+
+    call_timer(const call_timer &) = delete;
+    call_timer &operator=(const call_timer &) = delete;
+
+private:
+    cs_native_metric metric_;
+    bool active_;
+
+    std::chrono::steady_clock::time_point started_at_;
+};
+
+#endif //CS_NATIVE_INSTRUMENTATION_HPP
@@ -12,45 +12,106 @@
 
 #include <libtorrent/torrent_handle.hpp>
 
+class torrent_stream;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
     // session control
-    CSDL_EXPORT lt::session* create_session(lt::settings_pack* pack);
-    CSDL_EXPORT void destroy_session(lt::session* session);
+    CSDL_EXPORT cs_session* create_session(lt::settings_pack* pack);
+    CSDL_EXPORT cs_session* create_session_from_state(const char* data, int32_t length, uint32_t flags, lt::settings_pack* pack);
+    CSDL_EXPORT void destroy_session(cs_session* session);
+
+    CSDL_EXPORT void save_session_state(cs_session* session, uint32_t flags, session_state_buffer* state);
+    CSDL_EXPORT void destroy_session_state(session_state_buffer* state);
+
+    CSDL_EXPORT void set_event_callback(cs_session* session, cs_alert_callback callback, uint32_t event_flags);
+    CSDL_EXPORT void set_event_batch_callback(cs_session* session, cs_alert_batch_callback callback, uint32_t event_flags);
+    CSDL_EXPORT void clear_event_callback(cs_session* session);
+
+    CSDL_EXPORT void set_event_polling(cs_session* session, int32_t capacity, uint32_t event_flags);
+    CSDL_EXPORT int32_t poll_alerts(cs_session* session, cs_alert_record* buffer, int32_t max);
+    CSDL_EXPORT int64_t get_dropped_alert_count(cs_session* session);
+
+    CSDL_EXPORT void set_alert_filter(cs_session* session, const cs_alert_filter* filter);
+    CSDL_EXPORT void set_peer_alert_aggregation(cs_session* session, int32_t window_ms, bool include_raw_alerts);
+    CSDL_EXPORT void set_status_update_interval(cs_session* session, int32_t interval_ms);
+
+    CSDL_EXPORT void get_alert_pump_stats(cs_session* session, cs_alert_pump_stats* stats);
+
+    CSDL_EXPORT void post_session_stats(cs_session* session);
+    CSDL_EXPORT int32_t get_session_stats_metrics(const session_stats_metric** metrics);
 
-    CSDL_EXPORT void set_event_callback(lt::session* session, cs_alert_callback callback, bool include_unmapped_events);
-    CSDL_EXPORT void clear_event_callback(lt::session* session);
+    CSDL_EXPORT void set_native_metrics_enabled(bool enabled);
+    CSDL_EXPORT bool get_native_metrics(int32_t metric, native_histogram* histogram);
 
-    CSDL_EXPORT void apply_settings(lt::session* session, lt::settings_pack* settings);
+    CSDL_EXPORT void apply_settings(cs_session* session, lt::settings_pack* settings);
+    CSDL_EXPORT int32_t get_listen_port(cs_session* session);
 
     // torrent control
-    CSDL_EXPORT lt::torrent_info* create_torrent_file(const char* file_path);
-    CSDL_EXPORT lt::torrent_info* create_torrent_bytes(const char* data, long length);
-    CSDL_EXPORT void destroy_torrent(lt::torrent_info* torrent);
+    CSDL_EXPORT cs_torrent_info* create_torrent_file(const char* file_path);
+    CSDL_EXPORT cs_torrent_info* create_torrent_bytes(const char* data, long length);
+    CSDL_EXPORT void destroy_torrent(cs_torrent_info* torrent);
 
-    CSDL_EXPORT lt::torrent_handle* attach_torrent(lt::session* session, lt::torrent_info* torrent, const char* save_path);
-    CSDL_EXPORT void detach_torrent(lt::session* session, lt::torrent_handle* torrent);
+    CSDL_EXPORT lt::torrent_handle* attach_torrent(cs_session* session, cs_torrent_info* torrent, const char* save_path);
+    CSDL_EXPORT lt::torrent_handle* attach_torrent_with_resume(cs_session* session, cs_torrent_info* torrent, const char* save_path, const char* resume_data, int32_t resume_data_length);
+    CSDL_EXPORT void detach_torrent(cs_session* session, lt::torrent_handle* torrent);
+
+    CSDL_EXPORT int32_t attach_torrents_async(cs_session* session, const attach_request* requests, int32_t count);
+    CSDL_EXPORT lt::torrent_handle* copy_torrent_handle(lt::torrent_handle* torrent);
+
+    // magnet links
+    CSDL_EXPORT void set_metadata_cache_dir(cs_session* session, const char* directory);
+    CSDL_EXPORT lt::torrent_handle* attach_magnet(cs_session* session, const char* magnet_uri, const char* save_path);
+    CSDL_EXPORT cs_torrent_info* get_torrent_handle_info(lt::torrent_handle* torrent);
+    CSDL_EXPORT void get_torrent_info_hash(lt::torrent_handle* torrent, char* info_hash);
+
+    // resume data
+    CSDL_EXPORT void save_resume_data(lt::torrent_handle* torrent, uint32_t flags);
+    CSDL_EXPORT int32_t save_all_resume_data(cs_session* session, uint32_t flags);
 
     // torrent info
-    CSDL_EXPORT torrent_metadata* get_torrent_info(lt::torrent_info* torrent);
+    CSDL_EXPORT torrent_metadata* get_torrent_info(cs_torrent_info* torrent);
     CSDL_EXPORT void destroy_torrent_info(torrent_metadata* info);
 
     // file listing
-    CSDL_EXPORT void get_torrent_file_list(lt::torrent_info* torrent, torrent_file_list* file_list);
+    CSDL_EXPORT void get_torrent_file_list(cs_torrent_info* torrent, torrent_file_list* file_list);
+    CSDL_EXPORT void get_torrent_file_list_range(cs_torrent_info* torrent, int32_t start_index, int32_t count, torrent_file_list* file_list);
     CSDL_EXPORT void destroy_torrent_file_list(torrent_file_list* file_list);
 
     // priority control
     CSDL_EXPORT uint8_t get_file_dl_priority(lt::torrent_handle* torrent, int32_t file_index);
     CSDL_EXPORT void set_file_dl_priority(lt::torrent_handle* torrent, int32_t file_index, uint8_t priority);
 
+    CSDL_EXPORT int32_t get_file_priorities(lt::torrent_handle* torrent, uint8_t* priorities, int32_t count);
+    CSDL_EXPORT void set_file_priorities(lt::torrent_handle* torrent, const uint8_t* priorities, int32_t count);
+    CSDL_EXPORT void set_file_priorities_sparse(lt::torrent_handle* torrent, const file_priority_update* updates, int32_t count);
+
+    // file progress
+    CSDL_EXPORT int32_t get_file_progress(lt::torrent_handle* torrent, int64_t* progress, int32_t count, bool piece_granularity);
+
+    // streaming
+    CSDL_EXPORT torrent_stream* open_torrent_stream(lt::torrent_handle* torrent, int32_t file_index, int64_t read_ahead_bytes, int32_t deadline_step_ms);
+    CSDL_EXPORT void seek_torrent_stream(torrent_stream* stream, int64_t position);
+    CSDL_EXPORT int64_t get_torrent_stream_available(torrent_stream* stream);
+    CSDL_EXPORT void get_torrent_stream_stats(torrent_stream* stream, torrent_stream_stats* stats);
+    CSDL_EXPORT void close_torrent_stream(torrent_stream* stream);
+
+    // piece reads
+    CSDL_EXPORT void read_piece(lt::torrent_handle* torrent, int32_t piece);
+    CSDL_EXPORT boost::shared_array<char>* copy_piece_buffer(const boost::shared_array<char>* buffer);
+    CSDL_EXPORT void release_piece_buffer(boost::shared_array<char>* buffer);
+
     // download control
     CSDL_EXPORT void start_torrent(lt::torrent_handle* torrent);
     CSDL_EXPORT void stop_torrent(lt::torrent_handle* torrent);
     CSDL_EXPORT void reannounce_torrent(lt::torrent_handle* torrent, const int32_t seconds, const uint8_t ignore_min_interval);
+    CSDL_EXPORT bool connect_peer(lt::torrent_handle* torrent, const char* address, int32_t port);
 
     CSDL_EXPORT void get_torrent_status(lt::torrent_handle* torrent, torrent_status* torrent_status);
+    CSDL_EXPORT void get_torrent_status_ex(lt::torrent_handle* torrent, torrent_status_ex* status);
+    CSDL_EXPORT int32_t get_all_torrent_status(cs_session* session, torrent_status_entry* statuses, int32_t max);
 
 #ifdef __cplusplus
 }
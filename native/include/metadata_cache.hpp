@@ -0,0 +1,57 @@
+//
+// metadata_cache.hpp - on-disk cache of torrent metadata fetched from magnet links
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_METADATA_CACHE_HPP
+#define CS_NATIVE_METADATA_CACHE_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <libtorrent/info_hash.hpp>
+#include <libtorrent/torrent_handle.hpp>
+#include <libtorrent/torrent_info.hpp>
+
+// load cached metadata for a torrent, returning null if there isn't any (or it doesn't match the info hash).
+std::shared_ptr<lt::torrent_info> load_cached_metadata(const std::string &directory, const lt::info_hash_t &hashes);
+
+// write a torrent's metadata to the cache. failures are ignored, as the cache is only an optimisation.
+void store_cached_metadata(const std::string &directory, const lt::torrent_info &torrent);
+
+// writes metadata to the cache on its own thread, as fetching it from a handle is a round-trip to the network thread
+// and the write itself is disk io - neither should hold up alert delivery. the thread is started by the first write.
+class metadata_cache_writer {
+
+public:
+    metadata_cache_writer() = default;
+    ~metadata_cache_writer();
+
+    metadata_cache_writer(const metadata_cache_writer &) = delete;
+    metadata_cache_writer &operator=(const metadata_cache_writer &) = delete;
+
+    // queue the torrent's metadata to be written once it can be fetched from the handle
+    void enqueue(std::shared_ptr<const std::string> directory, lt::torrent_handle handle);
+
+    // drops anything still queued and waits for the current write to finish. must be called before the session is aborted,
+    // otherwise the writer can be left waiting on a network thread that has already exited.
+    void stop();
+
+private:
+    void run();
+
+    std::thread worker_;
+
+    std::mutex mutex_;
+    std::condition_variable signal_;
+
+    std::deque<std::pair<std::shared_ptr<const std::string>, lt::torrent_handle>> queue_;
+    bool stopping_ = false;
+};
+
+#endif //CS_NATIVE_METADATA_CACHE_HPP
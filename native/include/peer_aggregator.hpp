@@ -0,0 +1,50 @@
+//
+// peer_aggregator.hpp - folds peer alerts into periodic per-torrent summaries
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_PEER_AGGREGATOR_HPP
+#define CS_NATIVE_PEER_AGGREGATOR_HPP
+
+#include "events.h"
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <string_view>
+#include <vector>
+
+#include <libtorrent/alert_types.hpp>
+
+// only used from the alert pump thread, so needs no locking of its own.
+class peer_aggregator {
+
+public:
+    // set the window length, starting a fresh window if it changed. zero disables aggregation.
+    void configure(std::chrono::milliseconds window);
+
+    bool enabled() const {
+        return window_.count() > 0;
+    }
+
+    void add(const lt::peer_alert *alert, cs_peer_alert_type type, const lt::error_code *error);
+
+    // once the window has elapsed, append a summary for every torrent with peer activity and start a new window.
+    void flush_if_due(std::chrono::steady_clock::time_point now, std::vector<cs_alert_record> &summaries);
+
+private:
+    struct torrent_activity {
+        int32_t counts[CS_PEER_ALERT_TYPES]{};
+
+        std::set<lt::tcp::endpoint> endpoints;
+        // keyed by (category name, value), as the same value means different things in different categories
+        std::map<std::pair<std::string_view, int>, int32_t> errors;
+    };
+
+    std::chrono::milliseconds window_{0};
+    std::chrono::steady_clock::time_point window_start_;
+
+    std::map<lt::info_hash_t, torrent_activity> torrents_;
+};
+
+#endif //CS_NATIVE_PEER_AGGREGATOR_HPP
@@ -0,0 +1,212 @@
+//
+// session.hpp - per-session native state
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_SESSION_HPP
+#define CS_NATIVE_SESSION_HPP
+
+#include "events.h"
+#include "alert_filter.hpp"
+#include "alert_pump.hpp"
+#include "alert_ring.hpp"
+#include "metadata_cache.hpp"
+#include "peer_aggregator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <libtorrent/session.hpp>
+
+// bump allocator for alert messages, reset after every batch.
+// the buffer never grows, so pointers into it stay valid until the next reset.
+class message_arena {
+
+public:
+    static constexpr size_t capacity = 64 * 1024;
+
+    message_arena() : buffer_(std::make_unique<char[]>(capacity)) {
+    }
+
+    // copy a message into the arena, returning null if it doesn't fit
+    const char *store(const std::string &message) {
+        if (message.size() + 1 > capacity - used_) {
+            return nullptr;
+        }
+
+        auto target = buffer_.get() + used_;
+
+        std::copy(message.begin(), message.end(), target);
+        target[message.size()] = '\0';
+
+        used_ += message.size() + 1;
+        return target;
+    }
+
+    void reset() {
+        used_ = 0;
+    }
+
+private:
+    std::unique_ptr<char[]> buffer_;
+    size_t used_ = 0;
+};
+
+// storage for variable-length arrays carried by alert records (status updates, resume data), reset after every batch.
+// each alert gets its own buffer, so filling one never moves an array handed out earlier in the batch.
+template<typename T>
+class batch_buffers {
+
+public:
+    std::vector<T> &next() {
+        if (used_ == buffers_.size()) {
+            buffers_.emplace_back();
+        }
+
+        auto &buffer = buffers_[used_++];
+        buffer.clear();
+
+        return buffer;
+    }
+
+    void reset() {
+        used_ = 0;
+    }
+
+private:
+    std::vector<std::vector<T>> buffers_;
+    size_t used_ = 0;
+};
+
+// request ids for torrents submitted by attach_torrents_async, waiting on their add_torrent_alert.
+// ids are queued per info hash, so repeat submissions of the same torrent are matched up in order.
+class attach_requests {
+
+public:
+    // submit is run under the lock, so anything that can see the request (see pending) knows it has been submitted
+    template<typename F>
+    void add(const lt::info_hash_t &hashes, int64_t request_id, F &&submit) {
+        std::lock_guard guard(mutex_);
+        pending_.emplace(hashes, request_id);
+        submit();
+    }
+
+    size_t size() {
+        std::lock_guard guard(mutex_);
+        return pending_.size();
+    }
+
+    // info hashes of every torrent still waiting on its alert, with repeats for torrents submitted more than once
+    std::vector<lt::info_hash_t> pending() {
+        std::lock_guard guard(mutex_);
+        std::vector<lt::info_hash_t> hashes;
+
+        hashes.reserve(pending_.size());
+
+        for (const auto &[info_hashes, request_id]: pending_) {
+            hashes.push_back(info_hashes);
+        }
+
+        return hashes;
+    }
+
+    // remove and return the oldest id waiting on the torrent, or -1 if there isn't one
+    int64_t take(const lt::info_hash_t &hashes) {
+        std::lock_guard guard(mutex_);
+        auto it = pending_.find(hashes);
+
+        if (it == pending_.end()) {
+            return -1;
+        }
+
+        auto request_id = it->second;
+        pending_.erase(it);
+
+        return request_id;
+    }
+
+private:
+    std::mutex mutex_;
+    std::multimap<lt::info_hash_t, int64_t> pending_;
+};
+
+// alert dispatch configuration and scratch space, owned by a single session.
+struct alert_dispatcher {
+    ~alert_dispatcher() {
+        delete ring.load();
+    }
+
+    // guards the configuration below. drains take a copy up-front so callbacks are free to reconfigure the session.
+    std::mutex mutex;
+
+    // at most one delivery method is active at a time
+    cs_alert_callback callback = nullptr;
+    cs_alert_batch_callback batch_callback = nullptr;
+    bool polling = false;
+
+    uint32_t flags = event_flags_none;
+
+    // null lets everything through
+    std::shared_ptr<const alert_filter> filter;
+
+    // the alert_mask in place before a filter narrowed it, restored when the filter is cleared
+    std::optional<int> original_alert_mask;
+
+    // peer alert aggregation (see set_peer_alert_aggregation), disabled when the window is zero
+    int32_t peer_summary_window_ms = 0;
+    bool include_raw_peer_alerts = true;
+
+    // how often post_torrent_updates is requested (see set_status_update_interval), disabled when zero
+    int32_t status_update_interval_ms = 0;
+
+    // where metadata fetched for magnet links is cached (see set_metadata_cache_dir), null when disabled
+    std::shared_ptr<const std::string> metadata_cache_dir;
+
+    // written by attach_torrents_async, consumed by the pump thread
+    attach_requests attaches;
+
+    // scratch buffers, only touched by the pump thread
+    std::vector<lt::alert*> alerts;
+    std::vector<cs_alert_record> records;
+    message_arena messages;
+    batch_buffers<torrent_status_entry> statuses;
+    batch_buffers<char> resume_data;
+    batch_buffers<lt::torrent_handle> recovered_handles;
+    peer_aggregator peers;
+
+    // set when add_torrent_alerts were dropped from the queue, so the attaches waiting on them need looking up
+    bool attach_alerts_dropped = false;
+
+    // status update schedule, also only touched by the pump thread
+    int32_t status_update_scheduled_ms = 0;
+    std::chrono::steady_clock::time_point next_status_update;
+
+    // created by the first set_event_polling call and kept for the lifetime of the session,
+    // so poll_alerts never has to take the lock above.
+    std::atomic<alert_ring*> ring{nullptr};
+};
+
+// the handle returned by create_session.
+// members are destroyed in reverse order, so the pump is always stopped before the session it drains
+// (and before the metadata writer it queues work on).
+struct cs_session {
+    explicit cs_session(lt::session_params params) : session(std::move(params)) {
+    }
+
+    cs_session(const cs_session &) = delete;
+    cs_session &operator=(const cs_session &) = delete;
+
+    lt::session session;
+    metadata_cache_writer metadata_writer;
+    alert_dispatcher dispatcher;
+    alert_pump pump;
+};
+
+#endif //CS_NATIVE_SESSION_HPP
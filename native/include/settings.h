@@ -22,6 +22,12 @@ extern "C" {
     CSDL_EXPORT uint8_t settings_pack_set_bool(lt::settings_pack* pack, const char* key, uint8_t value);
     CSDL_EXPORT uint8_t settings_pack_set_int(lt::settings_pack* pack, const char* key, int value);
 
+    CSDL_EXPORT const char* settings_pack_get_str(lt::settings_pack* pack, const char* key);
+    CSDL_EXPORT uint8_t settings_pack_get_bool(lt::settings_pack* pack, const char* key, uint8_t* value);
+    CSDL_EXPORT uint8_t settings_pack_get_int(lt::settings_pack* pack, const char* key, int* value);
+
+    CSDL_EXPORT const char* settings_key_name(int32_t setting);
+
 #ifdef __cplusplus
 }
 #endif
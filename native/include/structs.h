@@ -8,8 +8,15 @@
 
 #include "struct_align.h"
 
+#include <memory>
 #include <libtorrent/session.hpp>
 
+// handle returned by create_torrent_file/create_torrent_bytes.
+// attached torrents share the parsed metadata instead of copying it, so it stays alive until both the handle and any torrents using it are gone.
+struct cs_torrent_info {
+    std::shared_ptr<lt::torrent_info> info;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -48,6 +55,94 @@ CSDL_STRUCT typedef struct cs_torrent_file_list {
     torrent_file_information* files;
 } torrent_file_list;
 
+// a single change passed to set_file_priorities_sparse
+CSDL_STRUCT typedef struct cs_file_priority {
+    int32_t file_index;
+    uint8_t priority;
+} file_priority_update;
+
+// playback metrics for a stream opened with open_torrent_stream
+CSDL_STRUCT typedef struct cs_torrent_stream_stats {
+    // the reader's current position within the file, and the pieces covered by the read-ahead window
+    int64_t position;
+    int32_t window_first_piece;
+    int32_t window_last_piece;
+
+    // time between opening the stream and the first byte becoming readable, or -1 if it hasn't yet
+    int64_t time_to_first_byte_ms;
+
+    // number of times (and total time) the reader was left waiting on data after playback started
+    int32_t stall_count;
+    int64_t stall_time_ms;
+
+    int32_t seek_count;
+} torrent_stream_stats;
+
+enum cs_stats_metric_type : int32_t {
+    stats_metric_counter = 0,
+    stats_metric_gauge = 1
+};
+
+// describes a single entry in cs_session_stats_alert::counters
+CSDL_STRUCT typedef struct cs_stats_metric {
+    const char* name;
+    int32_t value_index;
+    cs_stats_metric_type type;
+} session_stats_metric;
+
+// instrumented exports and internals, see set_native_metrics_enabled
+enum cs_native_metric : int32_t {
+    native_metric_create_session = 0,
+    native_metric_attach_torrent = 1,
+    native_metric_attach_torrents_async = 2,
+    native_metric_attach_magnet = 3,
+    native_metric_detach_torrent = 4,
+    native_metric_get_torrent_status = 5,
+    native_metric_get_torrent_status_ex = 6,
+    native_metric_get_all_torrent_status = 7,
+    native_metric_save_all_resume_data = 8,
+    native_metric_get_torrent_file_list = 9,
+    native_metric_get_file_progress = 10,
+    native_metric_get_file_priorities = 11,
+    native_metric_set_file_priorities = 12,
+    native_metric_poll_alerts = 13,
+
+    // time spent draining and delivering a batch of alerts
+    native_metric_alert_drain = 14,
+
+    // number of alerts popped per drain. values are alert counts rather than nanoseconds.
+    native_metric_alert_drain_size = 15
+};
+
+#define CS_NATIVE_METRIC_COUNT 16
+
+// log-linear buckets: values below 4 get their own bucket (0-3), after that each power of two is split into four.
+// bucket i (for i >= 8) starts at (4 + i % 4) << (i / 4 - 2), buckets 4-7 are never used. the last bucket also holds anything larger.
+#define CS_NATIVE_METRIC_BUCKETS 160
+
+CSDL_STRUCT typedef struct cs_native_histogram {
+    int64_t count;
+    int64_t total;
+    int64_t max;
+
+    int64_t buckets[CS_NATIVE_METRIC_BUCKETS];
+} native_histogram;
+
+// serialized session state, from save_session_state. freed with destroy_session_state.
+CSDL_STRUCT typedef struct cs_session_state {
+    int32_t length;
+    char* data;
+} session_state_buffer;
+
+// parts of the session to save/restore
+enum cs_session_state_flags : uint32_t {
+    session_state_none = 0,
+    session_state_settings = 1 << 0,
+    session_state_dht = 1 << 1,
+    session_state_extensions = 1 << 2,
+    session_state_ip_filter = 1 << 3
+};
+
 enum cs_torrent_state : int32_t {
     torrent_state_unknown = 0,
     torrent_checking = 1,
@@ -74,6 +169,99 @@ CSDL_STRUCT typedef struct cs_torrent_status {
     int64_t download_rate;
 } torrent_status;
 
+// optional (more expensive) parts of cs_torrent_status_ex, requested through its fields member
+enum cs_torrent_status_fields : uint32_t {
+    status_fields_none = 0,
+
+    // distributed_copies
+    status_field_distributed_copies = 1 << 0,
+
+    // total_done, flushing counters that are normally only updated periodically
+    status_field_accurate_counters = 1 << 1,
+
+    // last_seen_complete
+    status_field_last_seen_complete = 1 << 2,
+
+    // the piece bitfield, copied into the caller-provided pieces buffer
+    status_field_pieces = 1 << 3
+};
+
+// extended status, filled by a single status() call.
+// struct_size must be set to the size of the struct the caller was built against - nothing past it is read or written,
+// so new fields can be appended without breaking older callers.
+CSDL_STRUCT typedef struct cs_torrent_status_ex {
+    int32_t struct_size;
+    uint32_t fields;
+
+    torrent_status status;
+
+    int32_t num_pieces;
+    int32_t queue_position;
+
+    int64_t total_wanted;
+    int64_t total_wanted_done;
+    int64_t total_done;
+
+    float distributed_copies;
+
+    int32_t list_peers;
+    int32_t list_seeds;
+    int32_t connect_candidates;
+    int32_t num_connections;
+
+    int32_t num_complete;
+    int32_t num_incomplete;
+
+    // durations, in seconds
+    int64_t next_announce;
+    int64_t active_time;
+    int64_t finished_time;
+    int64_t seeding_time;
+
+    // unix timestamp, zero if never seen
+    int64_t last_seen_complete;
+
+    // one bit per piece, most significant bit first.
+    // pieces_size is the size of the buffer on input, and the number of bytes needed for the whole bitfield on output.
+    uint8_t* pieces;
+    int32_t pieces_size;
+
+    // the number of bits in the bitfield (the total number of pieces in the torrent)
+    int32_t pieces_count;
+} torrent_status_ex;
+
+// a single torrent to attach with attach_torrents_async
+CSDL_STRUCT typedef struct cs_attach_request {
+    cs_torrent_info* torrent;
+    const char* save_path;
+
+    // returned in the matching cs_torrent_added_alert
+    int64_t request_id;
+
+    // optional, see attach_torrent_with_resume
+    const char* resume_data;
+    int32_t resume_data_length;
+} attach_request;
+
+// options for save_resume_data/save_all_resume_data
+enum cs_resume_data_flags : uint32_t {
+    resume_flags_none = 0,
+
+    // flush the disk cache first, so the resume data reflects everything written so far
+    resume_flush_disk_cache = 1 << 0,
+
+    // include the torrent metadata, allowing the torrent to be re-attached from the resume data alone
+    resume_save_info_dict = 1 << 1,
+
+    // skip torrents that haven't changed since their resume data was last saved
+    resume_only_if_modified = 1 << 2
+};
+
+CSDL_STRUCT typedef struct cs_torrent_status_entry {
+    char info_hash[20];
+    torrent_status status;
+} torrent_status_entry;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,72 @@
+//
+// torrent_stream.hpp - read-ahead window for streaming a file out of a torrent
+// Created by Albie on 17/10/2026.
+//
+
+#ifndef CS_NATIVE_TORRENT_STREAM_HPP
+#define CS_NATIVE_TORRENT_STREAM_HPP
+
+#include "structs.h"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <libtorrent/torrent_handle.hpp>
+#include <libtorrent/torrent_info.hpp>
+
+// keeps piece deadlines set on a window of pieces ahead of a reader, so they're downloaded in time to be played back.
+// the file's pieces are raised to top priority while the stream is open, and put back when it closes. the torrent's
+// sequential_download flag and the rest of its pieces are left alone.
+// a stream is driven by a single reader and needs no locking of its own.
+class torrent_stream {
+
+public:
+    torrent_stream(lt::torrent_handle handle, std::shared_ptr<const lt::torrent_info> info, lt::file_index_t file, int64_t read_ahead_bytes, int32_t deadline_step_ms);
+    ~torrent_stream();
+
+    torrent_stream(const torrent_stream &) = delete;
+    torrent_stream &operator=(const torrent_stream &) = delete;
+
+    // move the reader to a byte offset within the file, sliding the window along with it
+    void seek(int64_t position);
+
+    // bytes that can be read from the current position without waiting, updating the stall metrics.
+    int64_t available();
+
+    void get_stats(torrent_stream_stats *stats) const;
+
+private:
+    // the piece containing a byte offset within the file
+    lt::piece_index_t piece_at(int64_t position) const;
+
+    void update_window();
+
+    lt::torrent_handle handle_;
+    std::shared_ptr<const lt::torrent_info> info_;
+
+    lt::file_index_t file_;
+    int64_t file_offset_;
+    int64_t file_size_;
+
+    int64_t read_ahead_bytes_;
+    int32_t deadline_step_ms_;
+
+    // the file's pieces this stream raised, with the priority to restore when it closes
+    std::vector<std::pair<lt::piece_index_t, lt::download_priority_t>> raised_pieces_;
+
+    int64_t position_ = 0;
+    int first_piece_ = -1;
+    int last_piece_ = -1;
+
+    std::chrono::steady_clock::time_point opened_at_;
+    std::optional<std::chrono::steady_clock::time_point> stalled_since_;
+
+    int64_t time_to_first_byte_ms_ = -1;
+    int32_t stall_count_ = 0;
+    std::chrono::steady_clock::duration stall_time_{};
+    int32_t seek_count_ = 0;
+};
+
+#endif //CS_NATIVE_TORRENT_STREAM_HPP
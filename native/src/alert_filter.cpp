@@ -0,0 +1,96 @@
+//
+// alert_filter.cpp - native-side alert filtering
+// Created by Albie on 17/10/2026.
+//
+
+#include "alert_filter.hpp"
+
+#include <libtorrent/alert_types.hpp>
+
+alert_filter::alert_filter(const cs_alert_filter &filter)
+        : alert_types_(filter.alert_types),
+          peer_alert_types_(filter.peer_alert_types),
+          category_mask_(static_cast<uint32_t>(filter.category_mask)) {
+    if (filter.info_hashes == nullptr || filter.info_hash_count <= 0) {
+        return;
+    }
+
+    info_hashes_.reserve(filter.info_hash_count);
+
+    for (int32_t i = 0; i < filter.info_hash_count; i++) {
+        info_hashes_.emplace_back(filter.info_hashes + (i * 20));
+    }
+
+    std::sort(info_hashes_.begin(), info_hashes_.end());
+}
+
+lt::alert_category_t alert_filter::required_categories() const {
+    lt::alert_category_t categories{};
+
+    auto allows_type = [this](cs_alert_type type) { return (alert_types_ & (1u << type)) != 0; };
+
+    if (allows_type(cs_alert_type::alert_generic)) {
+        categories |= lt::alert_category::all;
+    }
+
+    if (allows_type(cs_alert_type::alert_torrent_status)) {
+        categories |= lt::state_changed_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_torrent_removed)) {
+        categories |= lt::torrent_removed_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_torrent_status_updates)) {
+        categories |= lt::state_update_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_torrent_added)) {
+        categories |= lt::add_torrent_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_resume_data)) {
+        categories |= lt::save_resume_data_alert::static_category | lt::save_resume_data_failed_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_metadata_received)) {
+        categories |= lt::metadata_received_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_piece_read)) {
+        categories |= lt::read_piece_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_session_stats)) {
+        categories |= lt::session_stats_alert::static_category;
+    }
+
+    if (allows_type(cs_alert_type::alert_client_performance)) {
+        categories |= lt::performance_alert::static_category;
+    }
+
+    // summaries are built from the same peer alerts
+    if (allows_type(cs_alert_type::alert_peer_notification) || allows_type(cs_alert_type::alert_peer_summary)) {
+        if (allows(cs_peer_alert_type::connected_in) || allows(cs_peer_alert_type::connected_out)) {
+            categories |= lt::peer_connect_alert::static_category;
+        }
+
+        if (allows(cs_peer_alert_type::disconnected)) {
+            categories |= lt::peer_disconnected_alert::static_category;
+        }
+
+        if (allows(cs_peer_alert_type::banned)) {
+            categories |= lt::peer_ban_alert::static_category;
+        }
+
+        if (allows(cs_peer_alert_type::snubbed) || allows(cs_peer_alert_type::unsnubbed)) {
+            categories |= lt::peer_snubbed_alert::static_category | lt::peer_unsnubbed_alert::static_category;
+        }
+
+        if (allows(cs_peer_alert_type::errored)) {
+            categories |= lt::peer_error_alert::static_category;
+        }
+    }
+
+    return (categories & lt::alert_category_t(category_mask_)) | retained_categories;
+}
@@ -0,0 +1,178 @@
+//
+// alert_pump.cpp - long-lived alert dispatch thread
+// Created by Albie on 17/10/2026.
+//
+
+#include "alert_pump.hpp"
+
+alert_pump::~alert_pump() {
+    {
+        std::lock_guard guard(mutex_);
+        stopping_ = true;
+    }
+
+    signal_.notify_one();
+    join();
+}
+
+void alert_pump::start(drain_function drain) {
+    std::lock_guard guard(mutex_);
+    drain_ = std::make_shared<const drain_function>(std::move(drain));
+
+    if (worker_.joinable()) {
+        return;
+    }
+
+    stopping_ = false;
+    worker_ = std::thread(&alert_pump::run, this);
+    threads_started_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void alert_pump::stop() {
+    {
+        std::lock_guard guard(mutex_);
+        drain_.reset();
+
+        // can't join ourselves - leave the worker idle until the next start() or destruction
+        if (!worker_.joinable() || worker_.get_id() == std::this_thread::get_id()) {
+            return;
+        }
+
+        stopping_ = true;
+    }
+
+    signal_.notify_one();
+    join();
+}
+
+void alert_pump::retire(std::function<void()> on_exit) {
+    std::lock_guard guard(mutex_);
+
+    drain_.reset();
+    stopping_ = true;
+    on_exit_ = std::move(on_exit);
+}
+
+bool alert_pump::is_worker_thread() const {
+    return worker_.get_id() == std::this_thread::get_id();
+}
+
+void alert_pump::notify() {
+    notifications_.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        std::lock_guard guard(mutex_);
+
+        // coalesce with a wakeup that hasn't been serviced yet
+        if (pending_) {
+            return;
+        }
+
+        pending_ = true;
+        notified_at_ = std::chrono::steady_clock::now();
+    }
+
+    signal_.notify_one();
+}
+
+void alert_pump::set_interval(std::chrono::milliseconds interval) {
+    {
+        std::lock_guard guard(mutex_);
+
+        interval_ = interval;
+        next_tick_ = std::chrono::steady_clock::now() + interval;
+        rescheduled_ = true;
+    }
+
+    // let the worker pick up the new deadline
+    signal_.notify_one();
+}
+
+void alert_pump::get_stats(cs_alert_pump_stats *stats) const {
+    stats->threads_started = threads_started_.load(std::memory_order_relaxed);
+    stats->notifications = notifications_.load(std::memory_order_relaxed);
+    stats->wakeups = wakeups_.load(std::memory_order_relaxed);
+    stats->wakeup_latency_total_ns = wakeup_latency_total_ns_.load(std::memory_order_relaxed);
+    stats->wakeup_latency_max_ns = wakeup_latency_max_ns_.load(std::memory_order_relaxed);
+    stats->timer_ticks = timer_ticks_.load(std::memory_order_relaxed);
+}
+
+void alert_pump::run() {
+    std::unique_lock guard(mutex_);
+
+    while (true) {
+        auto woken = [this] { return pending_ || stopping_ || rescheduled_; };
+
+        // without a timer, sleep until notified. with one, also wake at the next tick.
+        if (interval_.count() > 0) {
+            signal_.wait_until(guard, next_tick_, woken);
+        } else {
+            signal_.wait(guard, woken);
+        }
+
+        if (stopping_) {
+            break;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        auto ticked = interval_.count() > 0 && now >= next_tick_;
+
+        rescheduled_ = false;
+
+        if (ticked) {
+            timer_ticks_.fetch_add(1, std::memory_order_relaxed);
+
+            // skip any ticks missed while draining rather than firing them back-to-back
+            while (next_tick_ <= now) {
+                next_tick_ += interval_;
+            }
+        } else if (!pending_) {
+            // only woken to pick up a new interval
+            continue;
+        }
+
+        if (pending_) {
+            pending_ = false;
+
+            auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - notified_at_).count();
+            auto max_latency = wakeup_latency_max_ns_.load(std::memory_order_relaxed);
+
+            wakeups_.fetch_add(1, std::memory_order_relaxed);
+            wakeup_latency_total_ns_.fetch_add(latency, std::memory_order_relaxed);
+
+            // only this thread writes the max, so a plain compare is enough
+            if (latency > max_latency) {
+                wakeup_latency_max_ns_.store(latency, std::memory_order_relaxed);
+            }
+        }
+
+        // hold a reference so start()/stop() can swap the function while it runs
+        auto drain = drain_;
+        guard.unlock();
+
+        if (drain) {
+            (*drain)();
+        }
+
+        guard.lock();
+    }
+
+    if (!on_exit_) {
+        return;
+    }
+
+    // retired from inside a drain - nothing can join this thread now, and the pump may be gone once on_exit returns
+    auto on_exit = std::move(on_exit_);
+
+    worker_.detach();
+    guard.unlock();
+
+    on_exit();
+}
+
+void alert_pump::join() {
+    // the worker never destroys the pump directly (see retire), so this is never waiting on itself
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
@@ -4,11 +4,16 @@
 //
 
 #include "events.h"
-#include "locks.hpp"
+#include "session.hpp"
+#include "peer_aggregator.hpp"
+#include "metadata_cache.hpp"
+#include "instrumentation.hpp"
 
 #include <ctime>
+#include <mutex>
 #include <libtorrent/session.hpp>
 #include <libtorrent/alert_types.hpp>
+#include <libtorrent/write_resume_data.hpp>
 
 void fill_info_hash(const lt::info_hash_t &hashes, char* buffer) {
     // fill in the info hash
@@ -19,18 +24,62 @@ void fill_info_hash(const lt::info_hash_t &hashes, char* buffer) {
     }
 }
 
-void fill_event_info(cs_alert* alert, lt::alert* lt_alert, cs_alert_type alert_type, std::string* message_temp) {
+// per-drain settings shared by every alert conversion
+struct conversion_context {
+    const alert_filter &filter;
+    message_arena *messages;
+
+    bool include_unmapped;
+
+    batch_buffers<torrent_status_entry> *statuses;
+    batch_buffers<char> *resume_data;
+    attach_requests *attaches;
+
+    // raised when the queue dropped add_torrent_alerts (see recover_dropped_attaches)
+    bool *attach_alerts_dropped;
+
+    // null when metadata caching is disabled
+    std::shared_ptr<const std::string> metadata_cache_dir;
+    metadata_cache_writer *metadata_writer;
+
+    // when set, peer alerts are folded into summaries. raw peer alerts are only converted if include_raw_peers is set.
+    peer_aggregator *peers;
+    bool include_raw_peers;
+};
+
+// messages are only formatted when an arena is provided (event_format_messages), and are left null if the arena is full.
+void fill_event_info(cs_alert* alert, lt::alert* lt_alert, cs_alert_type alert_type, message_arena* messages) {
     alert->type = alert_type;
 
     alert->epoch = time(nullptr);
     alert->category = (int32_t) static_cast<uint32_t>(lt_alert->category());
 
-    message_temp->append(lt_alert->message());
-    alert->message = message_temp->c_str();
+    alert->message = messages != nullptr ? messages->store(lt_alert->message()) : nullptr;
 }
 
-void populate_peer_alert(cs_peer_alert* peer_alert, lt::peer_alert* alert, cs_peer_alert_type alert_type, std::string* message) {
-    fill_event_info(&peer_alert->alert, alert, cs_alert_type::alert_peer_notification, message);
+bool populate_peer_alert(cs_peer_alert* peer_alert, lt::peer_alert* alert, cs_peer_alert_type alert_type, const lt::error_code* error, const conversion_context &context) {
+    auto &filter = context.filter;
+
+    if (!filter.allows(alert_type) || !filter.allows(alert->handle)) {
+        return false;
+    }
+
+    if (context.peers != nullptr) {
+        if (filter.allows(cs_alert_type::alert_peer_summary, alert)) {
+            context.peers->add(alert, alert_type, error);
+        }
+
+        if (!context.include_raw_peers) {
+            return false;
+        }
+    }
+
+    if (!filter.allows(cs_alert_type::alert_peer_notification, alert)) {
+        return false;
+    }
+
+    *peer_alert = {};
+    fill_event_info(&peer_alert->alert, alert, cs_alert_type::alert_peer_notification, context.messages);
 
     peer_alert->type = alert_type;
     peer_alert->handle = &alert->handle;
@@ -39,143 +88,512 @@ void populate_peer_alert(cs_peer_alert* peer_alert, lt::peer_alert* alert, cs_pe
     std::copy(v6_mapped_addr.begin(), v6_mapped_addr.end(), peer_alert->ipv6_address);
 
     fill_info_hash(alert->handle.info_hashes(), peer_alert->info_hash);
+    return true;
 }
 
-void on_events_available(lt::session* session, cs_alert_callback callback, bool include_unmapped) {
-    static std::mutex mutex;
-    lock l(mutex);
+// convert a libtorrent alert into its record form, returning false if there's nothing to deliver.
+// the record points into the alert and message arena, so it is only valid until the next pop_alerts call.
+bool convert_alert(lt::alert* alert, cs_alert_record* record, const conversion_context &context) {
+    auto &filter = context.filter;
+    auto messages = context.messages;
 
-    if (!l.isLockTaken()) {
-        return;
-    }
+    switch (alert->type()) {
 
-    std::vector<lt::alert*> events;
-    std::string message_temp;
+        // torrent state changed
+        case lt::state_changed_alert::alert_type: {
+            auto state_alert = lt::alert_cast<lt::state_changed_alert>(alert);
 
-    session->pop_alerts(&events);
+            if (!filter.allows(cs_alert_type::alert_torrent_status, alert) || !filter.allows(state_alert->handle)) {
+                return false;
+            }
 
-    handle_events:
-    for (auto &alert: events) {
-        switch (alert->type()) {
+            auto &status_alert = record->torrent_status;
+            status_alert = {};
 
-            // torrent state changed
-            case lt::state_changed_alert::alert_type: {
-                auto state_alert = lt::alert_cast<lt::state_changed_alert>(alert);
-                cs_torrent_status_alert status_alert{};
+            status_alert.new_state = state_alert->state;
+            status_alert.old_state = state_alert->prev_state;
 
-                status_alert.new_state = state_alert->state;
-                status_alert.old_state = state_alert->prev_state;
+            fill_info_hash(state_alert->handle.info_hashes(), status_alert.info_hash);
+            fill_event_info(&status_alert.alert, alert, cs_alert_type::alert_torrent_status, messages);
+            return true;
+        }
+
+            // periodic status updates (requested by the pump, see request_status_updates)
+        case lt::state_update_alert::alert_type: {
+            if (!filter.allows(cs_alert_type::alert_torrent_status_updates, alert)) {
+                return false;
+            }
+
+            auto update_alert = lt::alert_cast<lt::state_update_alert>(alert);
+            auto &statuses = context.statuses->next();
+
+            statuses.reserve(update_alert->status.size());
+
+            for (auto &status: update_alert->status) {
+                if (!filter.allows(status.info_hashes)) {
+                    continue;
+                }
+
+                auto &entry = statuses.emplace_back();
+
+                fill_info_hash(status.info_hashes, entry.info_hash);
+                fill_torrent_status(status, &entry.status);
+            }
 
-                fill_info_hash(state_alert->handle.info_hashes(), status_alert.info_hash);
-                fill_event_info(&status_alert.alert, alert, cs_alert_type::alert_torrent_status, &message_temp);
-                callback(&status_alert);
-                break;
+            if (statuses.empty()) {
+                return false;
             }
 
-                // torrent removed
-            case lt::torrent_removed_alert::alert_type: {
-                auto removed_alert = lt::alert_cast<lt::torrent_removed_alert>(alert);
-                cs_torrent_remove_alert removed_torrent{};
+            auto &updates = record->status_updates;
+            updates = {};
+
+            updates.count = static_cast<int32_t>(statuses.size());
+            updates.statuses = statuses.data();
+
+            fill_event_info(&updates.alert, alert, cs_alert_type::alert_torrent_status_updates, messages);
+            return true;
+        }
+
+            // torrent added
+        case lt::add_torrent_alert::alert_type: {
+            auto add_alert = lt::alert_cast<lt::add_torrent_alert>(alert);
+            auto hashes = add_alert->params.ti ? add_alert->params.ti->info_hashes() : add_alert->params.info_hashes;
 
-                // can't use handle as it's most likely been invalidated.
-                fill_info_hash(removed_alert->info_hashes, removed_torrent.info_hash);
-                fill_event_info(&removed_torrent.alert, alert, cs_alert_type::alert_torrent_removed, &message_temp);
-                callback(&removed_torrent);
-                break;
+            // always claim the request id, even if the alert is filtered out, so it can't be matched to a later attach
+            auto request_id = context.attaches->take(hashes);
+
+            if (!filter.allows(cs_alert_type::alert_torrent_added, alert) || !filter.allows(hashes)) {
+                return false;
             }
 
-                // performance warning
-            case lt::performance_alert::alert_type: {
-                auto perf_alert = lt::alert_cast<lt::performance_alert>(alert);
-                cs_client_performance_alert perf_warning{};
+            auto &added = record->torrent_added;
+            added = {};
+
+            added.request_id = request_id;
+            added.error_code = add_alert->error.value();
+            added.handle = add_alert->error ? nullptr : &add_alert->handle;
+
+            fill_info_hash(hashes, added.info_hash);
+            fill_event_info(&added.alert, alert, cs_alert_type::alert_torrent_added, messages);
+            return true;
+        }
+
+            // metadata downloaded for a magnet link
+        case lt::metadata_received_alert::alert_type: {
+            auto metadata_alert = lt::alert_cast<lt::metadata_received_alert>(alert);
 
-                perf_warning.warning_type = perf_alert->warning_code;
+            // cache regardless of the filter, so re-adding the magnet link can skip the download
+            if (context.metadata_cache_dir != nullptr) {
+                context.metadata_writer->enqueue(context.metadata_cache_dir, metadata_alert->handle);
+            }
 
-                fill_event_info(&perf_warning.alert, alert, cs_alert_type::alert_client_performance, &message_temp);
-                callback(&perf_warning);
-                break;
+            if (!filter.allows(cs_alert_type::alert_metadata_received, alert) || !filter.allows(metadata_alert->handle)) {
+                return false;
             }
 
-                // peer connected
-            case lt::peer_connect_alert::alert_type: {
-                auto peer_alert = lt::alert_cast<lt::peer_connect_alert>(alert);
-                auto direction = (peer_alert->direction == lt::peer_connect_alert::direction_t::in) ? cs_peer_alert_type::connected_in : cs_peer_alert_type::connected_out;
+            auto &received = record->metadata_received;
+            received = {};
+
+            received.handle = &metadata_alert->handle;
+
+            fill_info_hash(metadata_alert->handle.info_hashes(), received.info_hash);
+            fill_event_info(&received.alert, alert, cs_alert_type::alert_metadata_received, messages);
+            return true;
+        }
 
-                cs_peer_alert peer_connected{};
+            // piece read from disk (see read_piece)
+        case lt::read_piece_alert::alert_type: {
+            auto piece_alert = lt::alert_cast<lt::read_piece_alert>(alert);
 
-                populate_peer_alert(&peer_connected, peer_alert, direction, &message_temp);
-                callback(&peer_connected);
-                break;
+            if (!filter.allows(cs_alert_type::alert_piece_read, alert) || !filter.allows(piece_alert->handle)) {
+                return false;
             }
 
-                // peer disconnected
-            case lt::peer_disconnected_alert::alert_type: {
-                auto peer_alert = lt::alert_cast<lt::peer_disconnected_alert>(alert);
-                cs_peer_alert peer_disconnected{};
+            auto &piece_read = record->piece_read;
+            piece_read = {};
 
-                populate_peer_alert(&peer_disconnected, peer_alert, cs_peer_alert_type::disconnected, &message_temp);
-                callback(&peer_disconnected);
-                break;
+            piece_read.handle = &piece_alert->handle;
+            piece_read.piece = static_cast<int32_t>(piece_alert->piece);
+            piece_read.error_code = piece_alert->error.value();
+
+            // point at the alert's buffer rather than copying the piece out of it
+            if (!piece_alert->error && piece_alert->buffer) {
+                piece_read.size = piece_alert->size;
+                piece_read.data = piece_alert->buffer.get();
+                piece_read.buffer = &piece_alert->buffer;
             }
 
-                // peer banned
-            case lt::peer_ban_alert::alert_type: {
-                auto peer_alert = lt::alert_cast<lt::peer_ban_alert>(alert);
-                cs_peer_alert peer_banned{};
+            fill_info_hash(piece_alert->handle.info_hashes(), piece_read.info_hash);
+            fill_event_info(&piece_read.alert, alert, cs_alert_type::alert_piece_read, messages);
+            return true;
+        }
+
+            // resume data ready
+        case lt::save_resume_data_alert::alert_type: {
+            auto resume_alert = lt::alert_cast<lt::save_resume_data_alert>(alert);
 
-                populate_peer_alert(&peer_banned, peer_alert, cs_peer_alert_type::banned, &message_temp);
-                callback(&peer_banned);
-                break;
+            if (!filter.allows(cs_alert_type::alert_resume_data, alert) || !filter.allows(resume_alert->handle)) {
+                return false;
             }
 
-                // peer snubbed
-            case lt::peer_snubbed_alert::alert_type: {
-                auto peer_alert = lt::alert_cast<lt::peer_snubbed_alert>(alert);
-                cs_peer_alert peer_snubbed{};
+            auto &data = context.resume_data->next();
+            data = lt::write_resume_data_buf(resume_alert->params);
+
+            auto &resume = record->resume_data;
+            resume = {};
+
+            resume.handle = &resume_alert->handle;
+            resume.data = data.data();
+            resume.length = static_cast<int32_t>(data.size());
 
-                populate_peer_alert(&peer_snubbed, peer_alert, cs_peer_alert_type::snubbed, &message_temp);
-                callback(&peer_snubbed);
-                break;
+            fill_info_hash(resume_alert->handle.info_hashes(), resume.info_hash);
+            fill_event_info(&resume.alert, alert, cs_alert_type::alert_resume_data, messages);
+            return true;
+        }
+
+            // resume data couldn't be generated
+        case lt::save_resume_data_failed_alert::alert_type: {
+            auto failed_alert = lt::alert_cast<lt::save_resume_data_failed_alert>(alert);
+
+            if (!filter.allows(cs_alert_type::alert_resume_data, alert) || !filter.allows(failed_alert->handle)) {
+                return false;
             }
 
-                // peer unsnubbed
-            case lt::peer_unsnubbed_alert::alert_type: {
-                auto peer_alert = lt::alert_cast<lt::peer_unsnubbed_alert>(alert);
-                cs_peer_alert peer_unsnubbed{};
+            auto &resume = record->resume_data;
+            resume = {};
 
-                populate_peer_alert(&peer_unsnubbed, peer_alert, cs_peer_alert_type::unsnubbed, &message_temp);
-                callback(&peer_unsnubbed);
-                break;
+            resume.handle = &failed_alert->handle;
+            resume.error_code = failed_alert->error.value();
+
+            fill_info_hash(failed_alert->handle.info_hashes(), resume.info_hash);
+            fill_event_info(&resume.alert, alert, cs_alert_type::alert_resume_data, messages);
+            return true;
+        }
+
+            // torrent removed
+        case lt::torrent_removed_alert::alert_type: {
+            auto removed_alert = lt::alert_cast<lt::torrent_removed_alert>(alert);
+
+            if (!filter.allows(cs_alert_type::alert_torrent_removed, alert) || !filter.allows(removed_alert->info_hashes)) {
+                return false;
             }
 
-                // peer errored
-            case lt::peer_error_alert::alert_type: {
-                auto peer_alert = lt::alert_cast<lt::peer_error_alert>(alert);
-                cs_peer_alert peer_errored{};
+            auto &removed_torrent = record->torrent_removed;
+            removed_torrent = {};
+
+            // can't use handle as it's most likely been invalidated.
+            fill_info_hash(removed_alert->info_hashes, removed_torrent.info_hash);
+            fill_event_info(&removed_torrent.alert, alert, cs_alert_type::alert_torrent_removed, messages);
+            return true;
+        }
 
-                populate_peer_alert(&peer_errored, peer_alert, cs_peer_alert_type::errored, &message_temp);
-                callback(&peer_errored);
-                break;
+            // performance counters (see post_session_stats)
+        case lt::session_stats_alert::alert_type: {
+            if (!filter.allows(cs_alert_type::alert_session_stats, alert)) {
+                return false;
             }
 
-            default: {
-                if (!include_unmapped) {
-                    break;
-                }
+            auto stats_alert = lt::alert_cast<lt::session_stats_alert>(alert);
+            auto counters = stats_alert->counters();
+
+            auto &stats = record->session_stats;
+            stats = {};
 
-                cs_alert generic_alert{};
+            // the counters live in the alert, so they can be handed over without copying
+            stats.count = static_cast<int32_t>(counters.size());
+            stats.counters = counters.data();
 
-                fill_event_info(&generic_alert, alert, cs_alert_type::alert_generic, &message_temp);
-                callback(&generic_alert);
-                break;
+            fill_event_info(&stats.alert, alert, cs_alert_type::alert_session_stats, messages);
+            return true;
+        }
+
+            // performance warning
+        case lt::performance_alert::alert_type: {
+            if (!filter.allows(cs_alert_type::alert_client_performance, alert)) {
+                return false;
             }
+
+            auto perf_alert = lt::alert_cast<lt::performance_alert>(alert);
+            auto &perf_warning = record->performance;
+            perf_warning = {};
+
+            perf_warning.warning_type = perf_alert->warning_code;
+
+            fill_event_info(&perf_warning.alert, alert, cs_alert_type::alert_client_performance, messages);
+            return true;
+        }
+
+            // peer connected
+        case lt::peer_connect_alert::alert_type: {
+            auto peer_alert = lt::alert_cast<lt::peer_connect_alert>(alert);
+            auto direction = (peer_alert->direction == lt::peer_connect_alert::direction_t::in) ? cs_peer_alert_type::connected_in : cs_peer_alert_type::connected_out;
+
+            return populate_peer_alert(&record->peer, peer_alert, direction, nullptr, context);
+        }
+
+            // peer disconnected
+        case lt::peer_disconnected_alert::alert_type: {
+            auto peer_alert = lt::alert_cast<lt::peer_disconnected_alert>(alert);
+            return populate_peer_alert(&record->peer, peer_alert, cs_peer_alert_type::disconnected, &peer_alert->error, context);
+        }
+
+            // peer banned
+        case lt::peer_ban_alert::alert_type: {
+            auto peer_alert = lt::alert_cast<lt::peer_ban_alert>(alert);
+            return populate_peer_alert(&record->peer, peer_alert, cs_peer_alert_type::banned, nullptr, context);
+        }
+
+            // peer snubbed
+        case lt::peer_snubbed_alert::alert_type: {
+            auto peer_alert = lt::alert_cast<lt::peer_snubbed_alert>(alert);
+            return populate_peer_alert(&record->peer, peer_alert, cs_peer_alert_type::snubbed, nullptr, context);
+        }
+
+            // peer unsnubbed
+        case lt::peer_unsnubbed_alert::alert_type: {
+            auto peer_alert = lt::alert_cast<lt::peer_unsnubbed_alert>(alert);
+            return populate_peer_alert(&record->peer, peer_alert, cs_peer_alert_type::unsnubbed, nullptr, context);
+        }
+
+            // peer errored
+        case lt::peer_error_alert::alert_type: {
+            auto peer_alert = lt::alert_cast<lt::peer_error_alert>(alert);
+            return populate_peer_alert(&record->peer, peer_alert, cs_peer_alert_type::errored, &peer_alert->error, context);
+        }
+
+        default: {
+            if (auto dropped = lt::alert_cast<lt::alerts_dropped_alert>(alert); dropped != nullptr && dropped->dropped_alerts.test(lt::add_torrent_alert::alert_type)) {
+                *context.attach_alerts_dropped = true;
+            }
+
+            if (!context.include_unmapped || !filter.allows(cs_alert_type::alert_generic, alert)) {
+                return false;
+            }
+
+            record->alert = {};
+            fill_event_info(&record->alert, alert, cs_alert_type::alert_generic, messages);
+            return true;
         }
     }
+}
+
+// attaches whose add_torrent_alert was dropped from a full queue would never complete, so look their torrents up instead.
+// requests are registered and submitted under the same lock, and find_torrent is queued behind every add submitted before it,
+// so a torrent that can't be found failed to be added. records are appended from count onwards, returning the new count.
+size_t recover_dropped_attaches(cs_session* session, const conversion_context &context, std::vector<cs_alert_record> &records, size_t count) {
+    auto &dispatcher = session->dispatcher;
+    auto pending = dispatcher.attaches.pending();
+
+    // reserved up-front, so the handles records point at never move
+    auto &handles = dispatcher.recovered_handles.next();
+    handles.reserve(pending.size());
+
+    records.resize(count + pending.size());
+
+    for (auto &hashes: pending) {
+        auto handle = session->session.find_torrent(hashes.get_best());
+        auto request_id = dispatcher.attaches.take(hashes);
+
+        // the alert may have turned up since the snapshot was taken
+        if (request_id < 0) {
+            continue;
+        }
+
+        if (!context.filter.allows(cs_alert_type::alert_torrent_added, lt::add_torrent_alert::static_category) || !context.filter.allows(hashes)) {
+            continue;
+        }
+
+        auto &added = records[count++].torrent_added;
+        added = {};
+
+        added.request_id = request_id;
+
+        if (handle.is_valid()) {
+            added.handle = &handles.emplace_back(std::move(handle));
+        } else {
+            added.error_code = lt::errors::invalid_torrent_handle;
+        }
+
+        added.alert.type = cs_alert_type::alert_torrent_added;
+        added.alert.epoch = time(nullptr);
+        added.alert.category = (int32_t) static_cast<uint32_t>(lt::add_torrent_alert::static_category);
+
+        fill_info_hash(hashes, added.info_hash);
+    }
+
+    return count;
+}
+
+// ask libtorrent for the torrents that changed since the last request, once per interval.
+// the results arrive later as a state_update_alert.
+void request_status_updates(cs_session* session, int32_t interval_ms, std::chrono::steady_clock::time_point now) {
+    auto &dispatcher = session->dispatcher;
+
+    // post straight away when first enabled or the interval changes
+    if (interval_ms != dispatcher.status_update_scheduled_ms) {
+        dispatcher.status_update_scheduled_ms = interval_ms;
+        dispatcher.next_status_update = now;
+    }
+
+    if (interval_ms <= 0 || now < dispatcher.next_status_update) {
+        return;
+    }
+
+    // only the basic fields are mapped, so skip the optional ones
+    session->session.post_torrent_updates({});
+
+    const std::chrono::milliseconds interval(interval_ms);
+
+    while (dispatcher.next_status_update <= now) {
+        dispatcher.next_status_update += interval;
+    }
+}
 
-    events.clear();
-    session->pop_alerts(&events);
+// whether a callback has cleared delivery (or destroyed the session) part way through a drain.
+// the callbacks copied at the start may no longer be safe to call once it has.
+static bool delivery_cleared(alert_dispatcher &dispatcher) {
+    std::lock_guard l(dispatcher.mutex);
+    return dispatcher.callback == nullptr && dispatcher.batch_callback == nullptr && !dispatcher.polling;
+}
+
+// hand converted records to whichever delivery method is active.
+// returns false if a callback cleared delivery, in which case the rest of the records are dropped and the drain has to stop.
+bool deliver_records(alert_dispatcher &dispatcher, cs_alert_record* records, size_t count, cs_alert_callback callback, cs_alert_batch_callback batch_callback, alert_ring* ring) {
+    if (count == 0) {
+        return true;
+    }
+
+    if (ring != nullptr) {
+        // full rings drop the newest records, poll_alerts callers can see how many via the dropped count
+        for (size_t i = 0; i < count; i++) {
+            ring->push(records[i]);
+        }
+
+        return true;
+    }
+
+    if (batch_callback != nullptr) {
+        batch_callback(records, static_cast<int32_t>(count), sizeof(cs_alert_record));
+        return !delivery_cleared(dispatcher);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        callback(&records[i]);
+
+        if (delivery_cleared(dispatcher)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void on_events_available(cs_session* session) {
+    auto &dispatcher = session->dispatcher;
+
+    cs_alert_callback callback;
+    cs_alert_batch_callback batch_callback;
+    alert_ring* ring;
+    uint32_t flags;
+    std::shared_ptr<const alert_filter> filter;
+    int32_t peer_summary_window_ms;
+    bool include_raw_peers;
+    int32_t status_update_interval_ms;
+    std::shared_ptr<const std::string> metadata_cache_dir;
+
+    // only hold the session's own lock long enough to copy the configuration
+    {
+        std::lock_guard l(dispatcher.mutex);
+
+        callback = dispatcher.callback;
+        batch_callback = dispatcher.batch_callback;
+        ring = dispatcher.polling ? dispatcher.ring.load(std::memory_order_acquire) : nullptr;
+        flags = dispatcher.flags;
+        filter = dispatcher.filter;
+        peer_summary_window_ms = dispatcher.peer_summary_window_ms;
+        include_raw_peers = dispatcher.include_raw_peer_alerts;
+        status_update_interval_ms = dispatcher.status_update_interval_ms;
+        metadata_cache_dir = dispatcher.metadata_cache_dir;
+    }
+
+    if (callback == nullptr && batch_callback == nullptr && ring == nullptr) {
+        return;
+    }
+
+    // scratch buffers are reused between drains, and only ever touched by this session's pump thread
+    auto &events = dispatcher.alerts;
+    auto &records = dispatcher.records;
+    auto &peers = dispatcher.peers;
+
+    peers.configure(std::chrono::milliseconds(peer_summary_window_ms));
+
+    static const alert_filter allow_all;
+    const conversion_context context{
+        filter ? *filter : allow_all,
+        (flags & event_format_messages) ? &dispatcher.messages : nullptr,
+        (flags & event_include_unmapped) != 0,
+        &dispatcher.statuses,
+        &dispatcher.resume_data,
+        &dispatcher.attaches,
+        &dispatcher.attach_alerts_dropped,
+        metadata_cache_dir,
+        &session->metadata_writer,
+        peers.enabled() ? &peers : nullptr,
+        include_raw_peers
+    };
+
+    const call_timer timer(native_metric_alert_drain);
+    size_t drained = 0;
+
+    session->session.pop_alerts(&events);
+
+    while (!events.empty()) {
+        drained += events.size();
+
+        records.resize(events.size());
+        size_t count = 0;
+
+        if (context.messages != nullptr) {
+            context.messages->reset();
+        }
+
+        context.statuses->reset();
+        context.resume_data->reset();
+        dispatcher.recovered_handles.reset();
+
+        for (auto &alert: events) {
+            if (convert_alert(alert, &records[count], context)) {
+                count++;
+            }
+        }
+
+        if (dispatcher.attach_alerts_dropped) {
+            dispatcher.attach_alerts_dropped = false;
+            count = recover_dropped_attaches(session, context, records, count);
+        }
+
+        if (!deliver_records(dispatcher, records.data(), count, callback, batch_callback, ring)) {
+            return;
+        }
+
+        // records point into the alerts, which are invalidated by the next pop
+        events.clear();
+        session->session.pop_alerts(&events);
+    }
+
+    // the pump also wakes on a timer while aggregation or status updates are enabled, so both go out even when the session is quiet
+    const auto now = std::chrono::steady_clock::now();
+    request_status_updates(session, status_update_interval_ms, now);
+
+    records.clear();
+    peers.flush_if_due(now, records);
+
+    // the callbacks copied up-front may have been cleared (from another thread) since the last batch went out
+    if (ring != nullptr || records.empty() || !delivery_cleared(dispatcher)) {
+        deliver_records(dispatcher, records.data(), records.size(), callback, batch_callback, ring);
+    }
 
-    if (!events.empty()) {
-        goto handle_events;
+    if (instrumentation::enabled.load(std::memory_order_relaxed)) {
+        instrumentation::record(native_metric_alert_drain_size, static_cast<int64_t>(drained));
     }
 }
@@ -0,0 +1,141 @@
+//
+// instrumentation.cpp - opt-in latency histograms for the exported api
+// Created by Albie on 17/10/2026.
+//
+
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> instrumentation::enabled{false};
+
+namespace {
+    struct histogram_shard {
+        std::atomic<int64_t> count{0};
+        std::atomic<int64_t> total{0};
+        std::atomic<int64_t> max{0};
+
+        std::atomic<int64_t> buckets[CS_NATIVE_METRIC_BUCKETS]{};
+    };
+
+    // one per thread. only the owning thread writes, so updates are plain relaxed stores rather than atomic read-modify-writes.
+    struct thread_shard {
+        histogram_shard metrics[CS_NATIVE_METRIC_COUNT];
+    };
+
+    // shards are only registered/retired under the lock, the hot path never takes it
+    struct shard_registry {
+        std::mutex mutex;
+        std::vector<thread_shard *> shards;
+
+        // totals from threads that have exited
+        thread_shard retired;
+    };
+
+    shard_registry &registry() {
+        // leaked on purpose, threads can outlive static destruction
+        static auto *instance = new shard_registry;
+        return *instance;
+    }
+
+    void add_relaxed(std::atomic<int64_t> &target, int64_t value) {
+        target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    size_t bucket_for(int64_t value) {
+        if (value < 4) {
+            return static_cast<size_t>(std::max<int64_t>(value, 0));
+        }
+
+        // the top set bit picks the power of two, the two bits below it pick one of the four linear steps
+        const auto exponent = static_cast<size_t>(std::bit_width(static_cast<uint64_t>(value)) - 1);
+        const auto step = static_cast<size_t>(value >> (exponent - 2)) & 3;
+
+        return std::min<size_t>(exponent * 4 + step, CS_NATIVE_METRIC_BUCKETS - 1);
+    }
+
+    // registers the calling thread's shard on first use, folding it into the retired totals when the thread exits
+    class shard_owner {
+
+    public:
+        shard_owner() {
+            auto &reg = registry();
+            std::lock_guard guard(reg.mutex);
+
+            reg.shards.push_back(&shard_);
+        }
+
+        ~shard_owner() {
+            auto &reg = registry();
+            std::lock_guard guard(reg.mutex);
+
+            for (int metric = 0; metric < CS_NATIVE_METRIC_COUNT; metric++) {
+                auto &from = shard_.metrics[metric];
+                auto &to = reg.retired.metrics[metric];
+
+                add_relaxed(to.count, from.count.load(std::memory_order_relaxed));
+                add_relaxed(to.total, from.total.load(std::memory_order_relaxed));
+                to.max.store(std::max(to.max.load(std::memory_order_relaxed), from.max.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+
+                for (int i = 0; i < CS_NATIVE_METRIC_BUCKETS; i++) {
+                    add_relaxed(to.buckets[i], from.buckets[i].load(std::memory_order_relaxed));
+                }
+            }
+
+            std::erase(reg.shards, &shard_);
+        }
+
+        thread_shard &shard() {
+            return shard_;
+        }
+
+    private:
+        thread_shard shard_;
+    };
+}
+
+void instrumentation::record(cs_native_metric metric, int64_t value) {
+    if (metric < 0 || metric >= CS_NATIVE_METRIC_COUNT) {
+        return;
+    }
+
+    thread_local shard_owner owner;
+    auto &histogram = owner.shard().metrics[metric];
+
+    add_relaxed(histogram.count, 1);
+    add_relaxed(histogram.total, value);
+    add_relaxed(histogram.buckets[bucket_for(value)], 1);
+
+    if (value > histogram.max.load(std::memory_order_relaxed)) {
+        histogram.max.store(value, std::memory_order_relaxed);
+    }
+}
+
+void instrumentation::collect(cs_native_metric metric, native_histogram *histogram) {
+    *histogram = {};
+
+    auto &reg = registry();
+    std::lock_guard guard(reg.mutex);
+
+    auto add_shard = [histogram, metric](const thread_shard &shard) {
+        auto &source = shard.metrics[metric];
+
+        histogram->count += source.count.load(std::memory_order_relaxed);
+        histogram->total += source.total.load(std::memory_order_relaxed);
+        histogram->max = std::max(histogram->max, source.max.load(std::memory_order_relaxed));
+
+        for (int i = 0; i < CS_NATIVE_METRIC_BUCKETS; i++) {
+            histogram->buckets[i] += source.buckets[i].load(std::memory_order_relaxed);
+        }
+    };
+
+    add_shard(reg.retired);
+
+    for (auto *shard: reg.shards) {
+        add_shard(*shard);
+    }
+}
@@ -4,14 +4,198 @@
 //
 
 #include "library.h"
-
+#include "session.hpp"
+#include "metadata_cache.hpp"
+#include "torrent_stream.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <numeric>
+
+#include <libtorrent/address.hpp>
+#include <libtorrent/bdecode.hpp>
 #include <libtorrent/fingerprint.hpp>
+#include <libtorrent/magnet_uri.hpp>
+#include <libtorrent/read_resume_data.hpp>
+#include <libtorrent/session_params.hpp>
+#include <libtorrent/session_stats.hpp>
 #include <libtorrent/torrent_handle.hpp>
 
+// a single long-lived thread per session drains alerts, the notify hook only wakes it up
+static void start_alert_pump(cs_session* session)
+{
+    session->pump.start([session]() -> void
+    {
+        on_events_available(session);
+    });
+
+    session->session.set_alert_notify([session]() -> void
+    {
+        session->pump.notify();
+    });
+}
+
+// map the fields exposed through torrent_status. only uses fields populated regardless of status flags.
+void fill_torrent_status(const lt::torrent_status& s, torrent_status* torrent_status)
+{
+    if (s.errc != lt::error_code())
+    {
+        torrent_status->state = cs_torrent_state::torrent_error;
+    }
+    else
+    {
+        switch (s.state)
+        {
+        case lt::torrent_status::state_t::checking_files:
+            torrent_status->state = cs_torrent_state::torrent_checking;
+            break;
+
+        case lt::torrent_status::state_t::checking_resume_data:
+            torrent_status->state = cs_torrent_state::torrent_checking_resume;
+            break;
+
+        case lt::torrent_status::state_t::downloading_metadata:
+            torrent_status->state = cs_torrent_state::torrent_metadata_downloading;
+            break;
+
+        case lt::torrent_status::state_t::downloading:
+            torrent_status->state = cs_torrent_state::torrent_downloading;
+            break;
+
+        case lt::torrent_status::state_t::seeding:
+            torrent_status->state = cs_torrent_state::torrent_seeding;
+            break;
+
+        case lt::torrent_status::state_t::finished:
+            torrent_status->state = cs_torrent_state::torrent_finished;
+            break;
+
+        default:
+            torrent_status->state = cs_torrent_state::torrent_state_unknown;
+            break;
+        }
+    }
+
+    torrent_status->progress = s.progress;
+
+    torrent_status->count_peers = s.num_peers;
+    torrent_status->count_seeds = s.num_seeds;
+
+    torrent_status->bytes_uploaded = s.total_payload_upload;
+    torrent_status->bytes_downloaded = s.total_payload_download;
+
+    torrent_status->upload_rate = s.upload_payload_rate;
+    torrent_status->download_rate = s.download_payload_rate;
+}
+
+// the pump has a single timer, so tick at an interval that lands on every configured timer's deadline
+static void update_pump_interval(cs_session* session)
+{
+    int32_t interval_ms;
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+        interval_ms = std::gcd(session->dispatcher.peer_summary_window_ms, session->dispatcher.status_update_interval_ms);
+    }
+
+    session->pump.set_interval(std::chrono::milliseconds(interval_ms));
+}
+
+// shared setup for attach_torrent and attach_torrents_async.
+// resume data is optional - if it can't be parsed the torrent is added as new, and will be rechecked.
+static lt::add_torrent_params make_add_params(const cs_torrent_info* torrent, const char* save_path, const char* resume_data, int32_t resume_data_length)
+{
+    lt::add_torrent_params params;
+
+    if (resume_data != nullptr && resume_data_length > 0)
+    {
+        lt::error_code ec;
+        params = lt::read_resume_data({resume_data, resume_data_length}, ec);
+
+        if (ec)
+        {
+            params = {};
+        }
+    }
+
+    if (save_path != nullptr && *save_path != '\0')
+    {
+        params.save_path = save_path;
+    }
+
+    // enable paused-by-default, disable auto-management
+    params.flags |= lt::torrent_flags::paused;
+    params.flags &= ~lt::torrent_flags::auto_managed;
+
+    // share the parsed metadata with the torrent rather than copying it.
+    // without one, the metadata has to come from the resume data (saved with resume_save_info_dict).
+    if (torrent != nullptr)
+    {
+        params.ti = torrent->info;
+    }
+
+    return params;
+}
+
+static lt::resume_data_flags_t to_resume_flags(uint32_t flags)
+{
+    lt::resume_data_flags_t resume_flags{};
+
+    if (flags & resume_flush_disk_cache)
+    {
+        resume_flags |= lt::torrent_handle::flush_disk_cache;
+    }
+
+    if (flags & resume_save_info_dict)
+    {
+        resume_flags |= lt::torrent_handle::save_info_dict;
+    }
+
+    if (flags & resume_only_if_modified)
+    {
+        resume_flags |= lt::torrent_handle::only_if_modified;
+    }
+
+    return resume_flags;
+}
+
+static lt::save_state_flags_t to_save_state_flags(uint32_t flags)
+{
+    lt::save_state_flags_t save_flags{};
+
+    if (flags & session_state_settings)
+    {
+        save_flags |= lt::session_handle::save_settings;
+    }
+
+    if (flags & session_state_dht)
+    {
+        save_flags |= lt::session_handle::save_dht_state;
+    }
+
+    if (flags & session_state_extensions)
+    {
+        save_flags |= lt::session_handle::save_extension_state;
+    }
+
+    if (flags & session_state_ip_filter)
+    {
+        save_flags |= lt::session_handle::save_ip_filter;
+    }
+
+    return save_flags;
+}
+
 extern "C" {
 
-lt::session* create_session(lt::settings_pack* pack)
+cs_session* create_session(lt::settings_pack* pack)
 {
+    const call_timer timer(native_metric_create_session);
+
     lt::session_params params;
 
     if (pack != nullptr)
@@ -19,137 +203,710 @@ lt::session* create_session(lt::settings_pack* pack)
         params.settings = *pack;
     }
 
-    return new lt::session(params);
+    return new cs_session(std::move(params));
+}
+
+// create a session, restoring the parts of a previous session's state (from save_session_state) selected by flags.
+// if a settings pack is provided, it replaces any saved settings. returns null if the state couldn't be read.
+cs_session* create_session_from_state(const char* data, int32_t length, uint32_t flags, lt::settings_pack* pack)
+{
+    const call_timer timer(native_metric_create_session);
+
+    if (data == nullptr || length <= 0)
+    {
+        return nullptr;
+    }
+
+    lt::error_code ec;
+    const auto node = lt::bdecode({data, length}, ec);
+
+    if (ec)
+    {
+        return nullptr;
+    }
+
+    auto params = lt::read_session_params(node, to_save_state_flags(flags));
+
+    if (pack != nullptr)
+    {
+        params.settings = *pack;
+    }
+
+    return new cs_session(std::move(params));
+}
+
+// serialize the parts of the session's state selected by flags, so a later session can warm start from it.
+// the buffer is allocated on the heap and must be freed with a call to destroy_session_state.
+void save_session_state(cs_session* session, uint32_t flags, session_state_buffer* state)
+{
+    if (session == nullptr || state == nullptr)
+    {
+        return;
+    }
+
+    const auto save_flags = to_save_state_flags(flags);
+    const auto buffer = lt::write_session_params_buf(session->session.session_state(save_flags), save_flags);
+
+    state->length = static_cast<int32_t>(buffer.size());
+    state->data = new char[buffer.size()];
+
+    std::ranges::copy(buffer, state->data);
+}
+
+void destroy_session_state(session_state_buffer* state)
+{
+    if (state == nullptr || state->data == nullptr)
+    {
+        return;
+    }
+
+    delete[] state->data;
+
+    state->data = nullptr;
+    state->length = 0;
+}
+
+void destroy_session(cs_session* session)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    // stop delivering alerts before the session goes away
+    clear_event_callback(session);
+
+    // called from an alert callback - the pump thread is still inside the drain that made the call,
+    // so leave it to delete the session once the drain has returned
+    if (session->pump.is_worker_thread())
+    {
+        session->pump.retire([session]() -> void
+        {
+            session->metadata_writer.stop();
+            session->session.abort();
+            delete session;
+        });
+
+        return;
+    }
+
+    // the writer makes calls into the session, so has to finish before it's aborted
+    session->metadata_writer.stop();
+    session->session.abort();
+    delete session;
+}
+
+void apply_settings(cs_session* session, lt::settings_pack* settings)
+{
+    if (session == nullptr || settings == nullptr)
+    {
+        return;
+    }
+
+    session->session.apply_settings(*settings);
+}
+
+// the port the session is accepting connections on, or 0 if it isn't listening (yet).
+int32_t get_listen_port(cs_session* session)
+{
+    if (session == nullptr)
+    {
+        return 0;
+    }
+
+    return session->session.listen_port();
+}
+
+void set_event_callback(cs_session* session, cs_alert_callback callback, const uint32_t event_flags)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    if (callback == nullptr)
+    {
+        clear_event_callback(session);
+        return;
+    }
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+
+        session->dispatcher.callback = callback;
+        session->dispatcher.batch_callback = nullptr;
+        session->dispatcher.polling = false;
+        session->dispatcher.flags = event_flags;
+    }
+
+    start_alert_pump(session);
+}
+
+// deliver alerts as a contiguous array of cs_alert_record values, one call per batch popped from the session.
+// replaces any callback set with set_event_callback.
+void set_event_batch_callback(cs_session* session, cs_alert_batch_callback callback, const uint32_t event_flags)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    if (callback == nullptr)
+    {
+        clear_event_callback(session);
+        return;
+    }
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+
+        session->dispatcher.callback = nullptr;
+        session->dispatcher.batch_callback = callback;
+        session->dispatcher.polling = false;
+        session->dispatcher.flags = event_flags;
+    }
+
+    start_alert_pump(session);
+}
+
+void clear_event_callback(cs_session* session)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    session->session.set_alert_notify(nullptr);
+    session->pump.stop();
+
+    std::lock_guard guard(session->dispatcher.mutex);
+
+    session->dispatcher.callback = nullptr;
+    session->dispatcher.batch_callback = nullptr;
+    session->dispatcher.polling = false;
+}
+
+// queue alerts in a fixed-size ring for the caller to collect with poll_alerts, instead of pushing them through a callback.
+// the capacity is fixed by the first call, later calls only switch delivery back to polling.
+void set_event_polling(cs_session* session, const int32_t capacity, const uint32_t event_flags)
+{
+    if (session == nullptr || capacity <= 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+
+        if (session->dispatcher.ring.load(std::memory_order_relaxed) == nullptr)
+        {
+            session->dispatcher.ring.store(new alert_ring(capacity), std::memory_order_release);
+        }
+
+        session->dispatcher.callback = nullptr;
+        session->dispatcher.batch_callback = nullptr;
+        session->dispatcher.polling = true;
+        session->dispatcher.flags = event_flags;
+    }
+
+    start_alert_pump(session);
+}
+
+// copy up to max queued alerts into buffer, returning the number written.
+// records remain valid until the next call, and only a single thread may poll a session at a time.
+int32_t poll_alerts(cs_session* session, cs_alert_record* buffer, const int32_t max)
+{
+    const call_timer timer(native_metric_poll_alerts);
+
+    if (session == nullptr || buffer == nullptr || max <= 0)
+    {
+        return 0;
+    }
+
+    const auto ring = session->dispatcher.ring.load(std::memory_order_acquire);
+
+    if (ring == nullptr)
+    {
+        return 0;
+    }
+
+    return static_cast<int32_t>(ring->poll(buffer, max));
+}
+
+// the number of alerts discarded because the polling ring was full
+int64_t get_dropped_alert_count(cs_session* session)
+{
+    if (session == nullptr)
+    {
+        return 0;
+    }
+
+    const auto ring = session->dispatcher.ring.load(std::memory_order_acquire);
+    return ring == nullptr ? 0 : ring->dropped();
+}
+
+// filter alerts before they're converted, narrowing the session alert_mask to match.
+// passing null removes the filter and restores the alert_mask in place beforehand.
+void set_alert_filter(cs_session* session, const cs_alert_filter* filter)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    const auto native_filter = filter != nullptr ? std::make_shared<const alert_filter>(*filter) : nullptr;
+    const auto current_mask = session->session.get_settings().get_int(lt::settings_pack::alert_mask);
+
+    std::optional<int> alert_mask;
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+        auto& dispatcher = session->dispatcher;
+
+        if (native_filter != nullptr)
+        {
+            if (!dispatcher.original_alert_mask.has_value())
+            {
+                dispatcher.original_alert_mask = current_mask;
+            }
+
+            alert_mask = static_cast<int>(static_cast<uint32_t>(native_filter->required_categories()));
+        }
+        else if (dispatcher.original_alert_mask.has_value())
+        {
+            alert_mask = dispatcher.original_alert_mask;
+            dispatcher.original_alert_mask.reset();
+        }
+
+        dispatcher.filter = native_filter;
+    }
+
+    if (alert_mask.has_value())
+    {
+        lt::settings_pack pack;
+        pack.set_int(lt::settings_pack::alert_mask, alert_mask.value());
+
+        session->session.apply_settings(std::move(pack));
+    }
+}
+
+// fold peer alerts into a cs_peer_summary_alert per torrent every window_ms, emitted even if no other alerts arrive.
+// raw peer alerts are still delivered if include_raw_alerts is set. a window of zero disables aggregation.
+void set_peer_alert_aggregation(cs_session* session, int32_t window_ms, bool include_raw_alerts)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+
+        session->dispatcher.peer_summary_window_ms = std::max(window_ms, 0);
+        session->dispatcher.include_raw_peer_alerts = window_ms <= 0 || include_raw_alerts;
+    }
+
+    update_pump_interval(session);
+}
+
+// request a cs_torrent_status_update_alert listing the torrents whose status changed every interval_ms.
+// an interval of zero stops the updates.
+void set_status_update_interval(cs_session* session, int32_t interval_ms)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+        session->dispatcher.status_update_interval_ms = std::max(interval_ms, 0);
+    }
+
+    update_pump_interval(session);
+}
+
+void get_alert_pump_stats(cs_session* session, cs_alert_pump_stats* stats)
+{
+    if (session == nullptr || stats == nullptr)
+    {
+        return;
+    }
+
+    session->pump.get_stats(stats);
+}
+
+// request a snapshot of the session's performance counters, delivered as a cs_session_stats_alert.
+void post_session_stats(cs_session* session)
+{
+    if (session == nullptr)
+    {
+        return;
+    }
+
+    session->session.post_session_stats();
+}
+
+// get the names and types of the counters in cs_session_stats_alert, returning the number of metrics.
+// the table is built once and never freed, so it can be cached by the caller.
+int32_t get_session_stats_metrics(const session_stats_metric** metrics)
+{
+    // a plain array, as the struct's packing attributes would be dropped if it were used as a template argument
+    static int32_t count = 0;
+    static const session_stats_metric* table = []
+    {
+        const auto source = lt::session_stats_metrics();
+        auto entries = new session_stats_metric[source.size()];
+
+        // names point at static strings inside libtorrent, so they don't need copying
+        for (size_t i = 0; i < source.size(); i++)
+        {
+            entries[i] = {source[i].name, source[i].value_index, static_cast<cs_stats_metric_type>(source[i].type)};
+        }
+
+        count = static_cast<int32_t>(source.size());
+        return entries;
+    }();
+
+    if (metrics != nullptr)
+    {
+        *metrics = table;
+    }
+
+    return count;
+}
+
+// turn latency tracking for the instrumented exports (and alert drains) on or off. it's disabled by default.
+// histograms are kept while disabled, so turning it back on carries on from where it left off.
+void set_native_metrics_enabled(bool enabled)
+{
+    instrumentation::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// sum the histogram for a metric across every thread. returns false if the metric doesn't exist.
+bool get_native_metrics(int32_t metric, native_histogram* histogram)
+{
+    if (histogram == nullptr || metric < 0 || metric >= CS_NATIVE_METRIC_COUNT)
+    {
+        return false;
+    }
+
+    instrumentation::collect(static_cast<cs_native_metric>(metric), histogram);
+    return true;
+}
+
+cs_torrent_info* create_torrent_bytes(const char* data, long length)
+{
+    const lt::span buffer(data, length);
+    const lt::load_torrent_limits cfg;
+
+    return new cs_torrent_info{std::make_shared<lt::torrent_info>(buffer, cfg, lt::from_span)};
+}
+
+cs_torrent_info* create_torrent_file(const char* file_path)
+{
+    return new cs_torrent_info{std::make_shared<lt::torrent_info>(std::string(file_path))};
+}
+
+// releases the handle's reference to the metadata. any torrents attached with it keep their own reference.
+void destroy_torrent(cs_torrent_info* torrent)
+{
+    delete torrent;
+}
+
+// attach a torrent to the session, returning a handle that can be used to control the download.
+// the torrent info handle is shared with the torrent, and can be freed after the call to attach_torrent with a call to destroy_torrent.
+lt::torrent_handle* attach_torrent(cs_session* session, cs_torrent_info* torrent, const char* save_path)
+{
+    if (torrent == nullptr)
+    {
+        return nullptr;
+    }
+
+    return attach_torrent_with_resume(session, torrent, save_path, nullptr, 0);
+}
+
+// as attach_torrent, restoring state from resume data produced by save_resume_data to skip rechecking existing files.
+// torrent can be null if the resume data was saved with resume_save_info_dict.
+lt::torrent_handle* attach_torrent_with_resume(cs_session* session, cs_torrent_info* torrent, const char* save_path, const char* resume_data, int32_t resume_data_length)
+{
+    const call_timer timer(native_metric_attach_torrent);
+
+    if (session == nullptr || (torrent == nullptr && resume_data == nullptr))
+    {
+        return nullptr;
+    }
+
+    const auto params = make_add_params(torrent, save_path, resume_data, resume_data_length);
+    const auto handle = new lt::torrent_handle(session->session.add_torrent(params));
+
+    if (handle->is_valid())
+    {
+        return handle;
+    }
+
+    delete handle;
+    return nullptr;
 }
 
-void destroy_session(lt::session* session)
+// every attach posts an add_torrent_alert and a few state changes, which all have to fit in the alert queue alongside
+// everything else the session is doing. alerts that don't fit are dropped (and the attaches recovered the slow way).
+static constexpr int alerts_per_attach = 4;
+static constexpr int alert_queue_headroom = 2000;
+
+// grow alert_queue_size so the outstanding attaches fit, never shrinking a larger size set by the caller
+static void reserve_alert_queue(cs_session* session, size_t outstanding)
+{
+    const auto required = static_cast<int>(std::min<size_t>(outstanding * alerts_per_attach + alert_queue_headroom, INT_MAX));
+
+    if (session->session.get_settings().get_int(lt::settings_pack::alert_queue_size) >= required)
+    {
+        return;
+    }
+
+    lt::settings_pack pack;
+    pack.set_int(lt::settings_pack::alert_queue_size, required);
+
+    session->session.apply_settings(std::move(pack));
+}
+
+// queue a batch of torrents to be added without waiting on the network thread for each one.
+// each result is delivered as a cs_torrent_added_alert carrying the request's id. returns the number of torrents submitted.
+// as with attach_torrent, the torrent info handles can be freed once this returns.
+// alert_queue_size is raised to fit the batch, and results whose alert is still dropped are recovered by looking the torrent up.
+int32_t attach_torrents_async(cs_session* session, const attach_request* requests, int32_t count)
+{
+    const call_timer timer(native_metric_attach_torrents_async);
+
+    if (session == nullptr || requests == nullptr || count <= 0)
+    {
+        return 0;
+    }
+
+    reserve_alert_queue(session, session->dispatcher.attaches.size() + static_cast<size_t>(count));
+
+    int32_t submitted = 0;
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        const auto& request = requests[i];
+
+        if (request.torrent == nullptr && request.resume_data == nullptr)
+        {
+            continue;
+        }
+
+        auto params = make_add_params(request.torrent, request.save_path, request.resume_data, request.resume_data_length);
+
+        // register before submitting, the alert can arrive before async_add_torrent returns
+        session->dispatcher.attaches.add(params.ti ? params.ti->info_hashes() : params.info_hashes, request.request_id, [&]
+        {
+            session->session.async_add_torrent(std::move(params));
+        });
+
+        submitted++;
+    }
+
+    return submitted;
+}
+
+// cache metadata downloaded for magnet links in directory, so attaching the same link again doesn't need to fetch it from peers.
+// the cache is filled from metadata_received alerts, so any alert filter must leave the status category enabled.
+// passing null or an empty string disables the cache.
+void set_metadata_cache_dir(cs_session* session, const char* directory)
 {
     if (session == nullptr)
     {
         return;
     }
 
-    session->abort();
-    delete session;
+    std::shared_ptr<const std::string> cache_dir;
+
+    if (directory != nullptr && *directory != '\0')
+    {
+        cache_dir = std::make_shared<const std::string>(directory);
+    }
+
+    std::lock_guard guard(session->dispatcher.mutex);
+    session->dispatcher.metadata_cache_dir = std::move(cache_dir);
+}
+
+// attach a torrent from a magnet link, returning null if the link couldn't be parsed or the torrent is already attached.
+// if the metadata is in the cache it's used straight away, otherwise a cs_metadata_received_alert is raised once it's been downloaded.
+lt::torrent_handle* attach_magnet(cs_session* session, const char* magnet_uri, const char* save_path)
+{
+    const call_timer timer(native_metric_attach_magnet);
+
+    if (session == nullptr || magnet_uri == nullptr)
+    {
+        return nullptr;
+    }
+
+    lt::error_code ec;
+    auto params = lt::parse_magnet_uri(magnet_uri, ec);
+
+    if (ec)
+    {
+        return nullptr;
+    }
+
+    // adding a duplicate would return the existing torrent's handle
+    if (session->session.find_torrent(params.info_hashes.get_best()).is_valid())
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<const std::string> cache_dir;
+
+    {
+        std::lock_guard guard(session->dispatcher.mutex);
+        cache_dir = session->dispatcher.metadata_cache_dir;
+    }
+
+    if (cache_dir)
+    {
+        params.ti = load_cached_metadata(*cache_dir, params.info_hashes);
+    }
+
+    if (save_path != nullptr && *save_path != '\0')
+    {
+        params.save_path = save_path;
+    }
+
+    params.flags &= ~lt::torrent_flags::auto_managed;
+
+    // paused torrents can't fetch metadata, so leave it running until the metadata has arrived and been checked
+    if (params.ti)
+    {
+        params.flags |= lt::torrent_flags::paused;
+    }
+    else
+    {
+        params.flags &= ~lt::torrent_flags::paused;
+        params.flags |= lt::torrent_flags::stop_when_ready;
+    }
+
+    const auto handle = new lt::torrent_handle(session->session.add_torrent(std::move(params)));
+
+    if (handle->is_valid())
+    {
+        return handle;
+    }
+
+    delete handle;
+    return nullptr;
 }
 
-void apply_settings(lt::session* session, lt::settings_pack* settings)
+// handles in alerts are only valid while the alert is, this creates one owned by the caller (freed by detach_torrent).
+lt::torrent_handle* copy_torrent_handle(lt::torrent_handle* torrent)
 {
-    if (session == nullptr || settings == nullptr)
+    if (torrent == nullptr || !torrent->is_valid())
     {
-        return;
+        return nullptr;
     }
 
-    session->apply_settings(*settings);
+    return new lt::torrent_handle(*torrent);
 }
 
-void set_event_callback(lt::session* session, cs_alert_callback callback, bool include_unmapped_events)
+// get the metadata for an attached torrent, returning null if it hasn't been downloaded yet (see attach_magnet).
+// the result should be freed with destroy_torrent.
+cs_torrent_info* get_torrent_handle_info(lt::torrent_handle* torrent)
 {
-    if (session == nullptr)
+    if (torrent == nullptr || !torrent->is_valid())
     {
-        return;
+        return nullptr;
     }
 
-    if (callback == nullptr)
-    {
-        clear_event_callback(session);
-        return;
-    }
+    const auto info = torrent->torrent_file();
 
-    auto session_callback = [session, callback, include_unmapped_events]() -> void
+    if (!info || !info->is_valid())
     {
-        std::thread(on_events_available, session, callback, include_unmapped_events).detach();
-    };
+        return nullptr;
+    }
 
-    session->set_alert_notify(session_callback);
+    // torrent_file() is read-only, so take a copy rather than sharing it
+    return new cs_torrent_info{std::make_shared<lt::torrent_info>(*info)};
 }
 
-void clear_event_callback(lt::session* session)
+// copy the v1 info hash of an attached torrent into a 20-byte buffer
+void get_torrent_info_hash(lt::torrent_handle* torrent, char* info_hash)
 {
-    if (session == nullptr)
+    if (torrent == nullptr || info_hash == nullptr || !torrent->is_valid())
     {
         return;
     }
 
-    session->set_alert_notify(nullptr);
+    fill_info_hash(torrent->info_hashes(), info_hash);
 }
 
-lt::torrent_info* create_torrent_bytes(const char* data, long length)
+// request resume data for a torrent, delivered as a cs_resume_data_alert.
+void save_resume_data(lt::torrent_handle* torrent, uint32_t flags)
 {
-    const lt::span buffer(data, length);
-    const lt::load_torrent_limits cfg;
-
-    return new lt::torrent_info(buffer, cfg, lt::from_span);
-}
+    if (torrent == nullptr)
+    {
+        return;
+    }
 
-lt::torrent_info* create_torrent_file(const char* file_path)
-{
-    return new lt::torrent_info(std::string(file_path));
+    torrent->save_resume_data(to_resume_flags(flags));
 }
 
-void destroy_torrent(lt::torrent_info* torrent)
+// request resume data for every torrent in the session, returning the number of cs_resume_data_alerts to expect.
+// with resume_only_if_modified, only torrents with changes since their last save are included, so shutdowns only write what changed.
+int32_t save_all_resume_data(cs_session* session, uint32_t flags)
 {
-    delete torrent;
-}
+    const call_timer timer(native_metric_save_all_resume_data);
 
-// attach a torrent to the session, returning a handle that can be used to control the download.
-// the torrent info handle is copied, and can be freed after the call to attach_torrent with a call to destroy_torrent_info.
-lt::torrent_handle* attach_torrent(lt::session* session, lt::torrent_info* torrent, const char* save_path)
-{
-    if (session == nullptr || torrent == nullptr)
+    if (session == nullptr)
     {
-        return nullptr;
+        return 0;
     }
 
-    lt::add_torrent_params params;
-    std::string save_path_copy(save_path);
+    const auto only_modified = (flags & resume_only_if_modified) != 0;
 
-    if (!save_path_copy.empty())
+    // a single trip to the network thread to find the torrents that need saving
+    const auto torrents = session->session.get_torrent_status([only_modified](const lt::torrent_status& status)
     {
-        params.save_path = save_path_copy;
-    }
-
-    // enable paused-by-default, disable auto-management
-    params.flags |= lt::torrent_flags::paused;
-    params.flags &= ~lt::torrent_flags::auto_managed;
+        return status.has_metadata && (!only_modified || status.need_save_resume);
+    }, {});
 
-    // set torrent info - make_shared creates a copy
-    params.ti = std::make_shared<lt::torrent_info>(*torrent);
-    const auto handle = new lt::torrent_handle(session->add_torrent(params));
+    const auto resume_flags = to_resume_flags(flags);
 
-    if (handle->is_valid())
+    for (const auto& status : torrents)
     {
-        return handle;
+        status.handle.save_resume_data(resume_flags);
     }
 
-    delete handle;
-    return nullptr;
+    return static_cast<int32_t>(torrents.size());
 }
 
 // after detaching the torrent, the torrent handle is no longer valid.
 // additionally, a call to destroy_torrent is not needed.
-void detach_torrent(lt::session* session, lt::torrent_handle* torrent)
+void detach_torrent(cs_session* session, lt::torrent_handle* torrent)
 {
+    const call_timer timer(native_metric_detach_torrent);
+
     if (session == nullptr || torrent == nullptr)
     {
         return;
     }
 
     torrent->pause();
-    session->remove_torrent(*torrent);
+    session->session.remove_torrent(*torrent);
 
     delete torrent;
 }
 
 // get the info for a torrent.
 // the torrent_info struct is allocated on the heap and must be freed with a call to destroy_torrent_info.
-torrent_metadata* get_torrent_info(lt::torrent_info* torrent)
+torrent_metadata* get_torrent_info(cs_torrent_info* handle)
 {
-    if (torrent == nullptr)
+    if (handle == nullptr)
     {
         return nullptr;
     }
 
+    const auto torrent = handle->info.get();
+
     auto name = torrent->name();
     auto author = torrent->creator();
     auto comment = torrent->comment();
@@ -212,47 +969,77 @@ void destroy_torrent_info(torrent_metadata* info)
 }
 
 // given a torrent handle, get the list of files in the torrent.
-void get_torrent_file_list(lt::torrent_info* torrent, torrent_file_list* file_list)
+void get_torrent_file_list(cs_torrent_info* torrent, torrent_file_list* file_list)
+{
+    if (torrent == nullptr)
+    {
+        return;
+    }
+
+    get_torrent_file_list_range(torrent, 0, torrent->info->files().num_files(), file_list);
+}
+
+// as get_torrent_file_list, only listing count files starting at start_index so huge torrents can be paged through.
+// the range is clamped to the files available, and file_list->length set to the number actually listed.
+void get_torrent_file_list_range(cs_torrent_info* torrent, int32_t start_index, int32_t count, torrent_file_list* file_list)
 {
+    const call_timer timer(native_metric_get_torrent_file_list);
+
     if (torrent == nullptr || file_list == nullptr)
     {
         return;
     }
 
-    const auto& files = torrent->files();
+    const auto& files = torrent->info->files();
 
-    const auto num_files = files.num_files();
-    const auto list = new torrent_file_information[num_files];
+    const auto first = std::clamp(start_index, 0, files.num_files());
+    const auto length = std::clamp(count, 0, files.num_files() - first);
 
-    for (lt::file_index_t i(0); i != files.end_file(); i++)
+    // gather the names and paths first, so the structs and strings can share a single allocation
+    std::string strings;
+    std::vector<std::pair<size_t, size_t>> offsets(length);
+
+    for (int32_t n = 0; n < length; n++)
     {
-        auto index = static_cast<int32_t>(i);
+        const lt::file_index_t i(first + n);
+
+        offsets[n].first = strings.size();
+        strings.append(files.file_name(i));
+        strings.push_back('\0');
+
+        offsets[n].second = strings.size();
+        strings.append(files.file_path(i));
+        strings.push_back('\0');
+    }
 
-        auto name = files.file_name(i);
-        auto path = files.file_path(i);
+    const auto header_size = sizeof(torrent_file_information) * length;
+    const auto block = new char[header_size + strings.size()];
+    const auto list = reinterpret_cast<torrent_file_information*>(block);
+    const auto string_block = block + header_size;
 
-        auto file_name = new char[name.size() + 1]();
-        auto file_path = new char[path.size() + 1]();
+    std::ranges::copy(strings, string_block);
 
-        list[index] = {
-            index,
+    for (int32_t n = 0; n < length; n++)
+    {
+        const lt::file_index_t i(first + n);
+
+        new (list + n) torrent_file_information{
+            first + n,
             files.file_offset(i),
             files.file_size(i),
             files.mtime(i),
-            file_name,
-            file_path,
+            string_block + offsets[n].first,
+            string_block + offsets[n].second,
             files.file_absolute_path(i),
             files.pad_file_at(i)
         };
-
-        std::ranges::copy(name, file_name);
-        std::ranges::copy(path, file_path);
     }
 
     file_list->files = list;
-    file_list->length = num_files;
+    file_list->length = length;
 }
 
+// the names and paths live in the same block as the structs, so the whole list is released at once
 void destroy_torrent_file_list(torrent_file_list* file_list)
 {
     if (file_list == nullptr || file_list->files == nullptr)
@@ -260,13 +1047,10 @@ void destroy_torrent_file_list(torrent_file_list* file_list)
         return;
     }
 
-    for (int i = 0; i < file_list->length; i++)
-    {
-        delete[] file_list->files[i].file_name;
-        delete[] file_list->files[i].file_path;
-    }
+    delete[] reinterpret_cast<char*>(file_list->files);
 
-    delete[] file_list->files;
+    file_list->files = nullptr;
+    file_list->length = 0;
 }
 
 // set the download priority for a file in a torrent.
@@ -291,6 +1075,198 @@ uint8_t get_file_dl_priority(lt::torrent_handle* torrent, const int32_t file_ind
     return static_cast<uint8_t>(torrent->file_priority(static_cast<lt::file_index_t>(file_index)));
 }
 
+// set the priority of every file in one go, so the piece picker is only updated once.
+// priorities is indexed by file, any files past count are reset to the default priority.
+void set_file_priorities(lt::torrent_handle* torrent, const uint8_t* priorities, int32_t count)
+{
+    const call_timer timer(native_metric_set_file_priorities);
+
+    if (torrent == nullptr || priorities == nullptr || count < 0)
+    {
+        return;
+    }
+
+    std::vector<lt::download_priority_t> file_priorities;
+    file_priorities.reserve(count);
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        file_priorities.emplace_back(priorities[i]);
+    }
+
+    torrent->prioritize_files(file_priorities);
+}
+
+// copy the priority of every file into priorities, returning the number of files in the torrent.
+// if that's larger than count, only the first count priorities were copied.
+int32_t get_file_priorities(lt::torrent_handle* torrent, uint8_t* priorities, int32_t count)
+{
+    const call_timer timer(native_metric_get_file_priorities);
+
+    if (torrent == nullptr || !torrent->is_valid())
+    {
+        return 0;
+    }
+
+    const auto file_priorities = torrent->get_file_priorities();
+    const auto copied = std::min<size_t>(std::max(count, 0), file_priorities.size());
+
+    for (size_t i = 0; i < copied && priorities != nullptr; i++)
+    {
+        priorities[i] = static_cast<uint8_t>(file_priorities[i]);
+    }
+
+    return static_cast<int32_t>(file_priorities.size());
+}
+
+// change the priority of a subset of files, leaving the rest as they are. out of range indices are ignored.
+// the current priorities are read back first, so changes made concurrently through another call may be overwritten.
+void set_file_priorities_sparse(lt::torrent_handle* torrent, const file_priority_update* updates, int32_t count)
+{
+    const call_timer timer(native_metric_set_file_priorities);
+
+    if (torrent == nullptr || updates == nullptr || count <= 0 || !torrent->is_valid())
+    {
+        return;
+    }
+
+    const auto info = torrent->torrent_file();
+    const auto file_count = info ? info->num_files() : 0;
+
+    auto file_priorities = torrent->get_file_priorities();
+
+    // the list can be shorter than the number of files if priorities haven't been set yet
+    if (static_cast<int>(file_priorities.size()) < file_count)
+    {
+        file_priorities.resize(file_count, lt::default_priority);
+    }
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        const auto& update = updates[i];
+
+        if (update.file_index >= 0 && static_cast<size_t>(update.file_index) < file_priorities.size())
+        {
+            file_priorities[update.file_index] = lt::download_priority_t(update.priority);
+        }
+    }
+
+    torrent->prioritize_files(file_priorities);
+}
+
+// copy the bytes downloaded for each file into progress, indexed by file. returns the number of files in the torrent,
+// which can be larger than count if the buffer was too small. piece_granularity only counts complete pieces, which is much cheaper.
+int32_t get_file_progress(lt::torrent_handle* torrent, int64_t* progress, int32_t count, bool piece_granularity)
+{
+    const call_timer timer(native_metric_get_file_progress);
+
+    if (torrent == nullptr || !torrent->is_valid())
+    {
+        return 0;
+    }
+
+    // reused between calls, so polling progress doesn't allocate every time
+    thread_local std::vector<std::int64_t> file_progress;
+
+    torrent->file_progress(file_progress, piece_granularity ? lt::torrent_handle::piece_granularity : lt::file_progress_flags_t{});
+
+    if (progress != nullptr && count > 0)
+    {
+        const auto copied = std::min<size_t>(count, file_progress.size());
+        std::copy_n(file_progress.begin(), copied, progress);
+    }
+
+    return static_cast<int32_t>(file_progress.size());
+}
+
+// open a read-ahead window over a file, so it can be played back while it downloads.
+// pieces within read_ahead_bytes of the reader are given deadlines, deadline_step_ms apart, and the torrent switched to sequential download.
+// returns null if the torrent has no metadata yet or the file doesn't exist. closed with close_torrent_stream.
+torrent_stream* open_torrent_stream(lt::torrent_handle* torrent, int32_t file_index, int64_t read_ahead_bytes, int32_t deadline_step_ms)
+{
+    if (torrent == nullptr || !torrent->is_valid())
+    {
+        return nullptr;
+    }
+
+    auto info = torrent->torrent_file();
+
+    if (!info || file_index < 0 || file_index >= info->num_files())
+    {
+        return nullptr;
+    }
+
+    return new torrent_stream(*torrent, std::move(info), lt::file_index_t(file_index), read_ahead_bytes, deadline_step_ms);
+}
+
+// move the reader to a byte offset within the file. the window follows the reader, so this should also be called as data is read.
+void seek_torrent_stream(torrent_stream* stream, int64_t position)
+{
+    if (stream == nullptr)
+    {
+        return;
+    }
+
+    stream->seek(position);
+}
+
+// the number of bytes that can be read from the current position without waiting on the download.
+// readers should check this before each read - a result of zero counts as a stall.
+int64_t get_torrent_stream_available(torrent_stream* stream)
+{
+    if (stream == nullptr)
+    {
+        return 0;
+    }
+
+    return stream->available();
+}
+
+void get_torrent_stream_stats(torrent_stream* stream, torrent_stream_stats* stats)
+{
+    if (stream == nullptr || stats == nullptr)
+    {
+        return;
+    }
+
+    stream->get_stats(stats);
+}
+
+// clears any outstanding deadlines and frees the stream
+void close_torrent_stream(torrent_stream* stream)
+{
+    delete stream;
+}
+
+// read a downloaded piece back from disk, delivered as a cs_piece_read_alert.
+// only verified pieces can be read - anything else fails with an error code.
+void read_piece(lt::torrent_handle* torrent, int32_t piece)
+{
+    if (torrent == nullptr || !torrent->is_valid())
+    {
+        return;
+    }
+
+    torrent->read_piece(lt::piece_index_t(piece));
+}
+
+// piece buffers in alerts are only valid while the alert is, this shares ownership of one with the caller (freed by release_piece_buffer).
+// the data isn't copied, so the data pointer from the alert stays valid until the returned buffer is released.
+boost::shared_array<char>* copy_piece_buffer(const boost::shared_array<char>* buffer)
+{
+    if (buffer == nullptr || !*buffer)
+    {
+        return nullptr;
+    }
+
+    return new boost::shared_array<char>(*buffer);
+}
+
+void release_piece_buffer(boost::shared_array<char>* buffer)
+{
+    delete buffer;
+}
+
 // start and stop the download of a torrent.
 void start_torrent(lt::torrent_handle* torrent)
 {
@@ -330,63 +1306,156 @@ void reannounce_torrent(lt::torrent_handle* torrent, const int32_t seconds, cons
     torrent->force_reannounce(seconds, -1, flags);
 }
 
+// connect to a peer directly, without waiting for a tracker or the dht to find it.
+// returns false if the address couldn't be parsed.
+bool connect_peer(lt::torrent_handle* torrent, const char* address, const int32_t port)
+{
+    if (torrent == nullptr || address == nullptr || port <= 0 || port > 65535)
+    {
+        return false;
+    }
+
+    lt::error_code ec;
+    const auto ip = lt::make_address(address, ec);
+
+    if (ec)
+    {
+        return false;
+    }
+
+    torrent->connect_peer({ip, static_cast<uint16_t>(port)});
+    return true;
+}
+
 // get the progress of a torrent.
 void get_torrent_status(lt::torrent_handle* torrent, torrent_status* torrent_status)
 {
+    const call_timer timer(native_metric_get_torrent_status);
+
     if (torrent == nullptr || torrent_status == nullptr)
     {
         return;
     }
 
-    const auto s = torrent->status();
+    fill_torrent_status(torrent->status(), torrent_status);
+}
 
-    if (s.errc != lt::error_code())
+// get the extended status of a torrent, only querying the optional fields that were asked for.
+void get_torrent_status_ex(lt::torrent_handle* torrent, torrent_status_ex* status)
+{
+    const call_timer timer(native_metric_get_torrent_status_ex);
+
+    if (torrent == nullptr || status == nullptr || status->struct_size < static_cast<int32_t>(offsetof(torrent_status_ex, status)))
     {
-        torrent_status->state = cs_torrent_state::torrent_error;
+        return;
     }
-    else
+
+    // work on a full-size copy so older (smaller) structs are only written up to their own size
+    const auto size = std::min<size_t>(status->struct_size, sizeof(torrent_status_ex));
+
+    torrent_status_ex ex{};
+    std::memcpy(&ex, status, size);
+
+    lt::status_flags_t flags{};
+
+    if (ex.fields & status_field_distributed_copies)
     {
-        switch (s.state)
-        {
-        case lt::torrent_status::state_t::checking_files:
-            torrent_status->state = cs_torrent_state::torrent_checking;
-            break;
+        flags |= lt::torrent_handle::query_distributed_copies;
+    }
 
-        case lt::torrent_status::state_t::checking_resume_data:
-            torrent_status->state = cs_torrent_state::torrent_checking_resume;
-            break;
+    if (ex.fields & status_field_accurate_counters)
+    {
+        flags |= lt::torrent_handle::query_accurate_download_counters;
+    }
 
-        case lt::torrent_status::state_t::downloading_metadata:
-            torrent_status->state = cs_torrent_state::torrent_metadata_downloading;
-            break;
+    if (ex.fields & status_field_last_seen_complete)
+    {
+        flags |= lt::torrent_handle::query_last_seen_complete;
+    }
 
-        case lt::torrent_status::state_t::downloading:
-            torrent_status->state = cs_torrent_state::torrent_downloading;
-            break;
+    if (ex.fields & status_field_pieces)
+    {
+        flags |= lt::torrent_handle::query_pieces;
+    }
 
-        case lt::torrent_status::state_t::seeding:
-            torrent_status->state = cs_torrent_state::torrent_seeding;
-            break;
+    const auto s = torrent->status(flags);
+    fill_torrent_status(s, &ex.status);
 
-        case lt::torrent_status::state_t::finished:
-            torrent_status->state = cs_torrent_state::torrent_finished;
-            break;
+    ex.num_pieces = s.num_pieces;
+    ex.queue_position = static_cast<int32_t>(s.queue_position);
 
-        default:
-            torrent_status->state = cs_torrent_state::torrent_state_unknown;
-            break;
+    ex.total_wanted = s.total_wanted;
+    ex.total_wanted_done = s.total_wanted_done;
+    ex.total_done = s.total_done;
+
+    ex.distributed_copies = s.distributed_copies;
+
+    ex.list_peers = s.list_peers;
+    ex.list_seeds = s.list_seeds;
+    ex.connect_candidates = s.connect_candidates;
+    ex.num_connections = s.num_connections;
+
+    ex.num_complete = s.num_complete;
+    ex.num_incomplete = s.num_incomplete;
+
+    ex.next_announce = std::chrono::duration_cast<std::chrono::seconds>(s.next_announce).count();
+    ex.active_time = s.active_duration.count();
+    ex.finished_time = s.finished_duration.count();
+    ex.seeding_time = s.seeding_duration.count();
+
+    ex.last_seen_complete = s.last_seen_complete;
+
+    if (ex.fields & status_field_pieces)
+    {
+        const auto piece_count = static_cast<int32_t>(s.pieces.size());
+        const auto required = (piece_count + 7) / 8;
+
+        // only copy the bitfield if the whole thing fits
+        if (ex.pieces != nullptr && ex.pieces_size >= required)
+        {
+            std::fill_n(ex.pieces, required, 0);
+
+            for (int32_t i = 0; i < piece_count; i++)
+            {
+                if (s.pieces[lt::piece_index_t(i)])
+                {
+                    ex.pieces[i / 8] |= 0x80 >> (i % 8);
+                }
+            }
         }
+
+        ex.pieces_size = required;
+        ex.pieces_count = piece_count;
     }
 
-    torrent_status->progress = s.progress;
+    std::memcpy(status, &ex, size);
+}
 
-    torrent_status->count_peers = s.num_peers;
-    torrent_status->count_seeds = s.num_seeds;
+// get the progress of every torrent in the session with a single trip to the network thread.
+// returns the total number of torrents, which may be larger than max if the buffer was too small.
+int32_t get_all_torrent_status(cs_session* session, torrent_status_entry* statuses, int32_t max)
+{
+    const call_timer timer(native_metric_get_all_torrent_status);
 
-    torrent_status->bytes_uploaded = s.total_payload_upload;
-    torrent_status->bytes_downloaded = s.total_payload_download;
+    if (session == nullptr)
+    {
+        return 0;
+    }
 
-    torrent_status->upload_rate = s.upload_payload_rate;
-    torrent_status->download_rate = s.download_payload_rate;
+    // the basic fields are always populated - skip the optional (and more expensive) ones
+    const auto all = session->session.get_torrent_status([](const lt::torrent_status&) { return true; }, {});
+
+    if (statuses != nullptr)
+    {
+        const auto count = std::min<size_t>(all.size(), std::max(max, 0));
+
+        for (size_t i = 0; i < count; i++)
+        {
+            fill_info_hash(all[i].info_hashes, statuses[i].info_hash);
+            fill_torrent_status(all[i], &statuses[i].status);
+        }
+    }
+
+    return static_cast<int32_t>(all.size());
 }
 }
@@ -0,0 +1,149 @@
+//
+// metadata_cache.cpp - on-disk cache of torrent metadata fetched from magnet links
+// Created by Albie on 17/10/2026.
+//
+
+#include "metadata_cache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+// entries are named after the v1 info hash in lowercase hex, so hybrid torrents share an entry with their v1-only magnet links.
+// v2-only torrents fall back to the truncated v2 hash.
+static std::filesystem::path cache_path(const std::string &directory, const lt::info_hash_t &hashes) {
+    static constexpr char digits[] = "0123456789abcdef";
+
+    const auto hash = hashes.has_v1() ? hashes.v1 : hashes.get_best();
+    std::string name;
+
+    for (auto byte: hash) {
+        name += digits[(byte >> 4) & 0xF];
+        name += digits[byte & 0xF];
+    }
+
+    return std::filesystem::path(directory) / (name + ".torrent");
+}
+
+// magnet links only carry the hashes they were made with, so only those have to match
+static bool matches(const lt::info_hash_t &cached, const lt::info_hash_t &requested) {
+    return (!requested.has_v1() || cached.v1 == requested.v1) && (!requested.has_v2() || cached.v2 == requested.v2);
+}
+
+std::shared_ptr<lt::torrent_info> load_cached_metadata(const std::string &directory, const lt::info_hash_t &hashes) {
+    std::ifstream file(cache_path(directory, hashes), std::ios::binary);
+
+    if (!file) {
+        return nullptr;
+    }
+
+    const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    lt::error_code ec;
+    auto torrent = std::make_shared<lt::torrent_info>(lt::span<const char>(buffer), ec, lt::from_span);
+
+    // a corrupt or mismatched entry is treated as a miss, the metadata will be fetched from peers instead
+    if (ec || !matches(torrent->info_hashes(), hashes)) {
+        return nullptr;
+    }
+
+    return torrent;
+}
+
+void store_cached_metadata(const std::string &directory, const lt::torrent_info &torrent) {
+    const auto info = torrent.info_section();
+
+    if (info.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const auto path = cache_path(directory, torrent.info_hashes());
+    auto temp_path = path;
+    temp_path += ".tmp";
+
+    // only the info dictionary is needed, wrapped into a minimal .torrent file
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+
+        file << "d4:info";
+        file.write(info.data(), static_cast<std::streamsize>(info.size()));
+        file << "e";
+
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+
+    // rename into place, so a crash mid-write never leaves a truncated entry behind
+    std::filesystem::rename(temp_path, path, ec);
+}
+
+metadata_cache_writer::~metadata_cache_writer() {
+    stop();
+}
+
+void metadata_cache_writer::enqueue(std::shared_ptr<const std::string> directory, lt::torrent_handle handle) {
+    {
+        std::lock_guard guard(mutex_);
+
+        if (stopping_) {
+            return;
+        }
+
+        queue_.emplace_back(std::move(directory), std::move(handle));
+
+        if (!worker_.joinable()) {
+            worker_ = std::thread(&metadata_cache_writer::run, this);
+        }
+    }
+
+    signal_.notify_one();
+}
+
+void metadata_cache_writer::stop() {
+    {
+        std::lock_guard guard(mutex_);
+
+        stopping_ = true;
+        queue_.clear();
+    }
+
+    signal_.notify_one();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void metadata_cache_writer::run() {
+    std::unique_lock guard(mutex_);
+
+    while (true) {
+        signal_.wait(guard, [this] { return stopping_ || !queue_.empty(); });
+
+        if (stopping_) {
+            break;
+        }
+
+        auto [directory, handle] = std::move(queue_.front());
+        queue_.pop_front();
+
+        guard.unlock();
+
+        // the torrent may have been removed since the metadata arrived, in which case there's nothing to write
+        try {
+            if (auto torrent = handle.torrent_file()) {
+                store_cached_metadata(*directory, *torrent);
+            }
+        } catch (const std::exception &) {
+        }
+
+        guard.lock();
+    }
+}
@@ -0,0 +1,76 @@
+//
+// peer_aggregator.cpp - folds peer alerts into periodic per-torrent summaries
+// Created by Albie on 17/10/2026.
+//
+
+#include "peer_aggregator.hpp"
+
+#include <algorithm>
+#include <ctime>
+
+void peer_aggregator::configure(std::chrono::milliseconds window) {
+    if (window == window_) {
+        return;
+    }
+
+    window_ = window;
+    window_start_ = std::chrono::steady_clock::now();
+
+    torrents_.clear();
+}
+
+void peer_aggregator::add(const lt::peer_alert *alert, cs_peer_alert_type type, const lt::error_code *error) {
+    auto &activity = torrents_[alert->handle.info_hashes()];
+
+    activity.counts[type]++;
+    activity.endpoints.insert(alert->endpoint);
+
+    if (error != nullptr && error->failed()) {
+        activity.errors[{error->category().name(), error->value()}]++;
+    }
+}
+
+void peer_aggregator::flush_if_due(std::chrono::steady_clock::time_point now, std::vector<cs_alert_record> &summaries) {
+    if (!enabled() || now - window_start_ < window_) {
+        return;
+    }
+
+    std::vector<std::pair<std::pair<std::string_view, int>, int32_t>> errors;
+
+    for (auto &[info_hashes, activity]: torrents_) {
+        cs_alert_record record{};
+        auto &summary = record.peer_summary;
+
+        summary.alert.type = cs_alert_type::alert_peer_summary;
+        summary.alert.epoch = time(nullptr);
+        summary.alert.category = static_cast<int32_t>(static_cast<uint32_t>(lt::alert_category::peer | lt::alert_category::connect));
+
+        fill_info_hash(info_hashes, summary.info_hash);
+        summary.window_ms = static_cast<int32_t>(window_.count());
+
+        std::copy(std::begin(activity.counts), std::end(activity.counts), summary.counts);
+        summary.unique_endpoints = static_cast<int32_t>(activity.endpoints.size());
+
+        // pick out the most frequent error codes
+        errors.assign(activity.errors.begin(), activity.errors.end());
+
+        auto top_count = std::min<size_t>(errors.size(), CS_PEER_SUMMARY_TOP_ERRORS);
+        std::partial_sort(errors.begin(), errors.begin() + top_count, errors.end(), [](const auto &a, const auto &b) {
+            return a.second > b.second;
+        });
+
+        for (size_t i = 0; i < top_count; i++) {
+            summary.top_error_categories[i] = errors[i].first.first.data();
+            summary.top_error_codes[i] = errors[i].first.second;
+            summary.top_error_counts[i] = errors[i].second;
+        }
+
+        summaries.push_back(record);
+    }
+
+    torrents_.clear();
+
+    // keep windows aligned to the original start rather than drifting with pump latency
+    auto elapsed = (now - window_start_) / window_;
+    window_start_ += elapsed * window_;
+}
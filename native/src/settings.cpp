@@ -5,6 +5,13 @@
 
 #include "settings.h"
 
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <magic_enum/magic_enum.hpp>
 
 #pragma region "enum mapping"
@@ -31,22 +38,135 @@ namespace magic_enum::customize {
     };    
 }
 
-template <typename T>
-typename std::enable_if<std::is_enum<T>::value, bool>::type
-set_value(const char* key, std::function<bool(T)> setter)
+#pragma endregion
+
+#pragma region "lookup table"
+
+static bool less_case_insensitive(std::string_view a, std::string_view b)
+{
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), [](unsigned char x, unsigned char y)
+    {
+        return std::tolower(x) < std::tolower(y);
+    });
+}
+
+// setting names resolved once into a sorted table, so lookups are a binary search rather than a case-insensitive scan over every name.
+// ids carry their type in the top bits (see settings_pack::type_mask), so a single table covers all three types.
+class settings_table
+{
+public:
+    settings_table()
+    {
+        add_names<lt::settings_pack::string_types>(lt::settings_pack::max_string_setting_internal);
+        add_names<lt::settings_pack::int_types>(lt::settings_pack::max_int_setting_internal);
+        add_names<lt::settings_pack::bool_types>(lt::settings_pack::max_bool_setting_internal);
+
+        // names are only referenced once every list is complete, so nothing moves underneath them
+        for (const auto& names : names_)
+        {
+            for (const auto& [id, name] : names)
+            {
+                entries_.push_back({name, id});
+            }
+        }
+
+        std::sort(entries_.begin(), entries_.end(), [](const entry& a, const entry& b)
+        {
+            return less_case_insensitive(a.name, b.name);
+        });
+    }
+
+    // the id for a setting name (case-insensitive), or -1 if there isn't one
+    int find(std::string_view name) const
+    {
+        const auto it = std::lower_bound(entries_.begin(), entries_.end(), name, [](const entry& e, std::string_view key)
+        {
+            return less_case_insensitive(e.name, key);
+        });
+
+        if (it == entries_.end() || less_case_insensitive(name, it->name))
+        {
+            return -1;
+        }
+
+        return it->id;
+    }
+
+    // the name for a setting id, or null if there isn't one
+    const char* name(int id) const
+    {
+        const auto type = static_cast<size_t>((id & lt::settings_pack::type_mask) >> 14);
+        const auto index = static_cast<size_t>(id & lt::settings_pack::index_mask);
+
+        if (id < 0 || type >= std::size(names_) || index >= names_[type].size() || names_[type][index].first != id)
+        {
+            return nullptr;
+        }
+
+        return names_[type][index].second.c_str();
+    }
+
+private:
+    struct entry
+    {
+        std::string_view name;
+        int id;
+    };
+
+    // indexed by type (string, int, bool), then by the setting's index within that type
+    std::vector<std::pair<int, std::string>> names_[3];
+    std::vector<entry> entries_;
+
+    template <typename T>
+    void add_names(T end)
+    {
+        const auto type = static_cast<size_t>((static_cast<int>(end) & lt::settings_pack::type_mask) >> 14);
+        auto& names = names_[type];
+
+        for (const auto& [value, name] : magic_enum::enum_entries<T>())
+        {
+            const auto id = static_cast<int>(value);
+
+            // the end marker isn't a real setting
+            if (value == end)
+            {
+                continue;
+            }
+
+            const auto index = static_cast<size_t>(id & lt::settings_pack::index_mask);
+
+            if (index >= names.size())
+            {
+                names.resize(index + 1, {-1, {}});
+            }
+
+            names[index] = {id, std::string(name)};
+        }
+    }
+};
+
+static const settings_table& settings()
+{
+    static const settings_table table;
+    return table;
+}
+
+// look up a setting of the given type, returning -1 if the key doesn't name one
+static int find_setting(const char* key, int type_base)
 {
     if (key == nullptr)
     {
-        return false;
+        return -1;
     }
 
-    auto enum_key = magic_enum::enum_cast<T>(key, magic_enum::case_insensitive);
-    if (!enum_key.has_value())
+    const auto id = settings().find(key);
+
+    if (id < 0 || (id & lt::settings_pack::type_mask) != type_base)
     {
-        return false;
+        return -1;
     }
 
-    return setter(enum_key.value());
+    return id;
 }
 
 #pragma endregion
@@ -66,47 +186,85 @@ void destroy_settings_pack(lt::settings_pack* pack)
 
 uint8_t settings_pack_set_str(lt::settings_pack* pack, const char* key, const char* value)
 {
-    if (pack == nullptr)
+    const auto id = find_setting(key, lt::settings_pack::string_type_base);
+
+    if (pack == nullptr || value == nullptr || id < 0)
     {
         return false;
     }
 
-    return set_value<lt::settings_pack::string_types>(key, [pack, value](lt::settings_pack::string_types key)
+    pack->set_str(id, std::string(value));
+    return true;
+}
+
+uint8_t settings_pack_set_bool(lt::settings_pack* pack, const char* key, uint8_t value)
+{
+    const auto id = find_setting(key, lt::settings_pack::bool_type_base);
+
+    if (pack == nullptr || id < 0)
     {
-        if (value == nullptr)
-        {
-            return false;
-        }
+        return false;
+    }
 
-        pack->set_str(key, std::string(value));
-        return true;
-    });
+    pack->set_bool(id, value);
+    return true;
 }
 
-uint8_t settings_pack_set_bool(lt::settings_pack* pack, const char* key, uint8_t value)
+uint8_t settings_pack_set_int(lt::settings_pack* pack, const char* key, int value)
 {
-    if (pack == nullptr)
+    const auto id = find_setting(key, lt::settings_pack::int_type_base);
+
+    if (pack == nullptr || id < 0)
     {
         return false;
     }
 
-    return set_value<lt::settings_pack::bool_types>(key, [pack, value](lt::settings_pack::bool_types key)
+    pack->set_int(id, value);
+    return true;
+}
+
+// the string is owned by the pack, and is only valid until the pack is changed or destroyed.
+// returns null if the key isn't a string setting or hasn't been set.
+const char* settings_pack_get_str(lt::settings_pack* pack, const char* key)
+{
+    const auto id = find_setting(key, lt::settings_pack::string_type_base);
+
+    if (pack == nullptr || id < 0 || !pack->has_val(id))
     {
-        pack->set_bool(key, value);
-        return true;
-    });
+        return nullptr;
+    }
+
+    return pack->get_str(id).c_str();
 }
 
-uint8_t settings_pack_set_int(lt::settings_pack* pack, const char* key, int value)
+uint8_t settings_pack_get_bool(lt::settings_pack* pack, const char* key, uint8_t* value)
 {
-    if (pack == nullptr)
+    const auto id = find_setting(key, lt::settings_pack::bool_type_base);
+
+    if (pack == nullptr || value == nullptr || id < 0 || !pack->has_val(id))
     {
         return false;
     }
 
-    return set_value<lt::settings_pack::int_types>(key, [pack, value](lt::settings_pack::int_types key)
+    *value = pack->get_bool(id);
+    return true;
+}
+
+uint8_t settings_pack_get_int(lt::settings_pack* pack, const char* key, int* value)
+{
+    const auto id = find_setting(key, lt::settings_pack::int_type_base);
+
+    if (pack == nullptr || value == nullptr || id < 0 || !pack->has_val(id))
     {
-        pack->set_int(key, value);
-        return true;
-    });
+        return false;
+    }
+
+    *value = pack->get_int(id);
+    return true;
+}
+
+// the key for a libtorrent setting id (settings_pack::string_types, int_types or bool_types), or null if it isn't one.
+const char* settings_key_name(int32_t setting)
+{
+    return settings().name(setting);
 }
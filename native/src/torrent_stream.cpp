@@ -0,0 +1,171 @@
+//
+// torrent_stream.cpp - read-ahead window for streaming a file out of a torrent
+// Created by Albie on 17/10/2026.
+//
+
+#include "torrent_stream.hpp"
+
+#include <algorithm>
+#include <vector>
+
+torrent_stream::torrent_stream(lt::torrent_handle handle, std::shared_ptr<const lt::torrent_info> info, lt::file_index_t file, int64_t read_ahead_bytes, int32_t deadline_step_ms)
+        : handle_(std::move(handle)),
+          info_(std::move(info)),
+          file_(file),
+          file_offset_(info_->files().file_offset(file)),
+          file_size_(info_->files().file_size(file)),
+          read_ahead_bytes_(std::max<int64_t>(read_ahead_bytes, 1)),
+          deadline_step_ms_(std::max(deadline_step_ms, 0)),
+          opened_at_(std::chrono::steady_clock::now()) {
+    // deadlines decide which pieces are requested first. the rest of the file is preferred over the rest of the torrent,
+    // but otherwise downloads in the usual order - nothing outside the file's pieces is touched.
+    if (file_size_ > 0) {
+        const auto priorities = handle_.get_piece_priorities();
+        std::vector<std::pair<lt::piece_index_t, lt::download_priority_t>> raised;
+
+        for (auto piece = static_cast<int>(piece_at(0)); piece <= static_cast<int>(piece_at(file_size_ - 1)) && piece < static_cast<int>(priorities.size()); piece++) {
+            const auto priority = priorities[piece];
+
+            // pieces that were deliberately skipped stay skipped
+            if (priority != lt::dont_download && priority != lt::top_priority) {
+                raised_pieces_.emplace_back(lt::piece_index_t(piece), priority);
+                raised.emplace_back(lt::piece_index_t(piece), lt::top_priority);
+            }
+        }
+
+        if (!raised.empty()) {
+            handle_.prioritize_pieces(raised);
+        }
+    }
+
+    update_window();
+}
+
+torrent_stream::~torrent_stream() {
+    // the torrent may have been removed while the stream was open
+    if (!handle_.is_valid()) {
+        return;
+    }
+
+    // streams can be closed from a finalizer, long after the torrent (or session) has gone away.
+    // the handle calls throw if that happens between the check above and here, which can't be allowed out of a destructor.
+    try {
+        for (int piece = first_piece_; piece >= 0 && piece <= last_piece_; piece++) {
+            handle_.reset_piece_deadline(lt::piece_index_t(piece));
+        }
+
+        if (!raised_pieces_.empty()) {
+            handle_.prioritize_pieces(raised_pieces_);
+        }
+    } catch (const std::exception &) {
+    }
+}
+
+void torrent_stream::seek(int64_t position) {
+    position = std::clamp<int64_t>(position, 0, file_size_);
+
+    // only jumps out of the window count as seeks, reading through the file moves the window along as well
+    auto piece = static_cast<int>(piece_at(position));
+
+    if (piece < first_piece_ || piece > last_piece_) {
+        seek_count_++;
+    }
+
+    position_ = position;
+    update_window();
+}
+
+int64_t torrent_stream::available() {
+    if (!handle_.is_valid() || position_ >= file_size_) {
+        return 0;
+    }
+
+    const int64_t piece_length = info_->piece_length();
+    const auto start = file_offset_ + position_;
+    const auto end = file_offset_ + file_size_;
+
+    // one snapshot of the bitfield, rather than a blocking have_piece call for every piece in the window
+    const auto pieces = handle_.status(lt::torrent_handle::query_pieces).pieces;
+
+    int64_t bytes = 0;
+
+    // count whole pieces from the reader onwards, stopping at the first one that's missing or the end of the window
+    for (auto piece = static_cast<int>(piece_at(position_)); piece <= last_piece_; piece++) {
+        if (piece >= pieces.size() || !pieces[lt::piece_index_t(piece)]) {
+            break;
+        }
+
+        bytes = std::min((piece + 1) * piece_length, end) - start;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+
+    if (bytes > 0) {
+        if (time_to_first_byte_ms_ < 0) {
+            time_to_first_byte_ms_ = std::chrono::duration_cast<std::chrono::milliseconds>(now - opened_at_).count();
+        }
+
+        if (stalled_since_.has_value()) {
+            stall_time_ += now - stalled_since_.value();
+            stalled_since_.reset();
+        }
+    } else if (time_to_first_byte_ms_ >= 0 && !stalled_since_.has_value()) {
+        // waiting before the first byte arrives is counted by time_to_first_byte instead
+        stall_count_++;
+        stalled_since_ = now;
+    }
+
+    return bytes;
+}
+
+void torrent_stream::get_stats(torrent_stream_stats *stats) const {
+    auto stall_time = stall_time_;
+
+    // include a stall that's still in progress
+    if (stalled_since_.has_value()) {
+        stall_time += std::chrono::steady_clock::now() - stalled_since_.value();
+    }
+
+    stats->position = position_;
+    stats->window_first_piece = first_piece_;
+    stats->window_last_piece = last_piece_;
+    stats->time_to_first_byte_ms = time_to_first_byte_ms_;
+    stats->stall_count = stall_count_;
+    stats->stall_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(stall_time).count();
+    stats->seek_count = seek_count_;
+}
+
+lt::piece_index_t torrent_stream::piece_at(int64_t position) const {
+    position = std::clamp<int64_t>(position, 0, std::max<int64_t>(file_size_ - 1, 0));
+    return lt::piece_index_t(static_cast<int>((file_offset_ + position) / info_->piece_length()));
+}
+
+void torrent_stream::update_window() {
+    if (!handle_.is_valid()) {
+        return;
+    }
+
+    const auto first = static_cast<int>(piece_at(position_));
+    const auto last = static_cast<int>(piece_at(position_ + read_ahead_bytes_ - 1));
+
+    // deadlines are relative to when they're set, so they're only refreshed once the reader moves onto another piece
+    if (first == first_piece_ && last == last_piece_) {
+        return;
+    }
+
+    // pieces that have fallen out of the window no longer need to be rushed
+    for (int piece = first_piece_; piece >= 0 && piece <= last_piece_; piece++) {
+        if (piece < first || piece > last) {
+            handle_.reset_piece_deadline(lt::piece_index_t(piece));
+        }
+    }
+
+    // the piece under the reader is the most urgent, with each one after it given a little longer.
+    // libtorrent ignores deadlines for pieces it already has.
+    for (int piece = first; piece <= last; piece++) {
+        handle_.set_piece_deadline(lt::piece_index_t(piece), (piece - first) * deadline_step_ms_);
+    }
+
+    first_piece_ = first;
+    last_piece_ = last;
+}